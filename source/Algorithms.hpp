@@ -0,0 +1,360 @@
+//
+//  ╦ ╦┬ ┬┌─┐┌─┐┬─┐  ╔╗ ┬ ┬┌─┐┌─┐┌─┐┬─┐
+//  ╠═╣└┬┘├─┘├┤ ├┬┘  ╠╩╗│ │├┤ ├┤ ├┤ ├┬┘
+//  ╩ ╩ ┴ ┴  └─┘┴└─  ╚═╝└─┘└  └  └─┘┴└─
+//
+//  © 2023 Lorenz Bucher - all rights reserved
+//  https://github.com/Sidelobe/HyperBuffer
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <type_traits>
+
+#include "HyperBuffer.hpp"
+#include "ThreadPool.hpp"
+
+// Hint that the iterations of the following loop are independent and may be vectorized
+#if defined(__clang__)
+    #define SLB_VECTORIZE_LOOP _Pragma("clang loop vectorize(enable) interleave(enable)")
+#elif defined(__GNUC__)
+    #define SLB_VECTORIZE_LOOP _Pragma("GCC ivdep")
+#elif defined(_MSC_VER)
+    #define SLB_VECTORIZE_LOOP __pragma(loop(ivdep))
+#else
+    #define SLB_VECTORIZE_LOOP
+#endif
+
+namespace slb
+{
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Execution modes of the algorithms (similar to the C++17 execution policies):
+//
+// - Sequential: the elements are processed one after the other, in the order of the indices
+// - Vectorized: the elements are processed in order of the rows, but the iterations are assumed to be independent,
+//   so they can be vectorized by the compiler; reductions may be re-associated (several accumulators)
+// - Parallel: the data is partitioned across the threads of a pool, every partition is processed like 'Vectorized'.
+//   The functions are called concurrently and must not have side effects on shared state.
+// ---------------------------------------------------------------------------------------------------------------------
+namespace Execution
+{
+struct Sequential {};
+struct Vectorized {};
+struct Parallel
+{
+    ThreadPool& pool;
+};
+} // namespace Execution
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Algorithms over all elements of buffers of any storage policy, in a given execution mode, e.g.
+//
+//     Algorithms::transform(Execution::Parallel{ pool }, dst, src, [](float x) { return std::tanh(x); });
+//     float energy = Algorithms::transformReduce(Execution::Vectorized{}, buffer, 0.f, std::plus<>{}, [](float x) { return x * x; });
+//
+// The data is processed in segments: all elements at once if all buffers are flat (one unpadded block), otherwise row
+// by row. In parallel, flat data is partitioned into chunks that start at cache line boundaries (no false sharing),
+// all other data at row boundaries (a row is never split across threads).
+// ---------------------------------------------------------------------------------------------------------------------
+namespace Algorithms
+{
+namespace detail
+{
+using BufferOperations::detail::areAllFlat;
+using BufferOperations::detail::firstElement;
+using BufferOperations::detail::haveSizes;
+using BufferOperations::detail::numElements;
+
+template<class Mode> struct IsUnsequenced : std::true_type {};
+template<> struct IsUnsequenced<Execution::Sequential> : std::false_type {};
+
+/** Maximum number of partial results of a parallel reduction (kept on the stack) */
+static constexpr int MaxNumPartitions = 256;
+
+/** @returns the pointer to the first element of the row with the given (flat) index */
+template<class Buffer>
+auto getRow(Buffer& buffer, offset_type rowIndex) noexcept
+{
+    constexpr int N = std::tuple_size<std::decay_t<decltype(buffer.sizes())>>::value;
+    return slb::detail::getRowPointer(std::integral_constant<int, N>{}, buffer.data(), buffer.sizes().data(), rowIndex);
+}
+
+/**
+ * Start of the given chunk when dividing n elements into numChunks, rounded down to a cache line boundary of `data`
+ * (for the chunks of different threads not to share any cache line).
+ */
+template<typename T>
+offset_type getChunkBegin(const T* data, offset_type n, int chunk, int numChunks) noexcept
+{
+    if (chunk >= numChunks) {
+        return n;
+    }
+    const offset_type elementsPerLine = std::max<offset_type>(1, static_cast<offset_type>(CacheLineSize / sizeof(T)));
+    const offset_type misalignment = static_cast<offset_type>(reinterpret_cast<std::uintptr_t>(data) % CacheLineSize) / static_cast<offset_type>(sizeof(T));
+    const offset_type begin = (n * chunk / numChunks + misalignment) / elementsPerLine * elementsPerLine - misalignment;
+    return std::min(std::max<offset_type>(begin, 0), n);
+}
+
+// MARK: segments
+
+/** Sequential traversal: calls `segmentOp(n, pointers...)` for every segment of the buffers */
+template<class Mode, class SegmentOp, class Buffer, class... Buffers>
+void forEachSegment(const Mode&, SegmentOp& segmentOp, Buffer& first, Buffers&... others)
+{
+    constexpr int N = std::tuple_size<std::decay_t<decltype(first.sizes())>>::value;
+    ASSERT(haveSizes<N>(first.sizes(), others...), "Extents of the buffers do not match");
+    if (N == 1 || areAllFlat(first, others...)) {
+        segmentOp(numElements(first.sizes()), firstElement(first.data()), firstElement(others.data())...);
+    } else {
+        BufferOperations::detail::forEachRow(std::integral_constant<int, N>{}, first.sizes().data(), segmentOp, first.data(), others.data()...);
+    }
+}
+
+/**
+ * Parallel traversal: calls `partitionOp(partition, segmentOp)` on the threads of the pool, which in turn has to call
+ * `segmentOp(n, pointers...)` for the segments of its partition.
+ * @returns the number of partitions
+ */
+template<class PartitionOp, class Buffer, class... Buffers>
+int forEachPartition(const Execution::Parallel& mode, PartitionOp partitionOp, Buffer& first, Buffers&... others)
+{
+    constexpr int N = std::tuple_size<std::decay_t<decltype(first.sizes())>>::value;
+    ASSERT(haveSizes<N>(first.sizes(), others...), "Extents of the buffers do not match");
+    const int numThreads = std::min(mode.pool.getNumThreads(), MaxNumPartitions);
+    const offset_type numTotal = numElements(first.sizes());
+
+    if (N == 1 || areAllFlat(first, others...)) {
+        const auto* data = firstElement(first.data());
+        const offset_type elementsPerLine = std::max<offset_type>(1, static_cast<offset_type>(CacheLineSize / sizeof(*data)));
+        const int numChunks = static_cast<int>(std::min<offset_type>(numThreads, (numTotal + elementsPerLine - 1) / elementsPerLine));
+        mode.pool.parallelFor(numChunks, [&](int chunk) {
+            const offset_type begin = getChunkBegin(data, numTotal, chunk, numChunks);
+            const offset_type end = getChunkBegin(data, numTotal, chunk + 1, numChunks);
+            partitionOp(chunk, [&](auto& segmentOp) {
+                segmentOp(end - begin, firstElement(first.data()) + begin, firstElement(others.data()) + begin...);
+            });
+        });
+        return numChunks;
+    }
+
+    const offset_type numRows = numTotal / first.size(N-1);
+    const int numPartitions = static_cast<int>(std::min<offset_type>(numThreads, numRows));
+    mode.pool.parallelFor(numPartitions, [&](int partition) {
+        partitionOp(partition, [&](auto& segmentOp) {
+            const offset_type end = numRows * (partition + 1) / numPartitions;
+            for (offset_type row = numRows * partition / numPartitions; row < end; ++row) {
+                segmentOp(static_cast<offset_type>(first.size(N-1)), getRow(first, row), getRow(others, row)...);
+            }
+        });
+    });
+    return numPartitions;
+}
+
+/** Calls `segmentOp(n, pointers...)` for every segment of the buffers, in parallel */
+template<class SegmentOp, class Buffer, class... Buffers>
+void forEachSegment(const Execution::Parallel& mode, SegmentOp& segmentOp, Buffer& first, Buffers&... others)
+{
+    forEachPartition(mode, [&segmentOp](int /*partition*/, auto forEachSegmentOfPartition) {
+        forEachSegmentOfPartition(segmentOp);
+    }, first, others...);
+}
+
+// MARK: element-wise
+
+/** Calls `function(elements...)` for every index of the segment */
+template<class Function, typename... P>
+void forEachElementOfSegment(std::false_type /*unsequenced*/, offset_type n, Function& function, P... pointers)
+{
+    for (offset_type i = 0; i < n; ++i) {
+        function(pointers[i]...);
+    }
+}
+
+template<class Function, typename... P>
+void forEachElementOfSegment(std::true_type /*unsequenced*/, offset_type n, Function& function, P... pointers)
+{
+    SLB_VECTORIZE_LOOP
+    for (offset_type i = 0; i < n; ++i) {
+        function(pointers[i]...);
+    }
+}
+
+template<class Mode, class Function, class... Buffers>
+void forEachElement(const Mode& mode, Function& function, Buffers&... buffers)
+{
+    auto segmentOp = [&function](offset_type n, auto... pointers) {
+        forEachElementOfSegment(IsUnsequenced<Mode>{}, n, function, pointers...);
+    };
+    forEachSegment(mode, segmentOp, buffers...);
+}
+
+// MARK: reduction
+
+/** Reduces the segment in order */
+template<typename R, class ReduceOp, class TransformOp, typename... P>
+R reduceSegment(std::false_type /*unsequenced*/, offset_type n, R result, ReduceOp& reduceOp, TransformOp& transformOp, P... pointers)
+{
+    for (offset_type i = 0; i < n; ++i) {
+        result = reduceOp(result, transformOp(pointers[i]...));
+    }
+    return result;
+}
+
+/** Reduces the segment with several independent accumulators, which can be vectorized */
+template<typename R, class ReduceOp, class TransformOp, typename... P>
+R reduceSegment(std::true_type /*unsequenced*/, offset_type n, R result, ReduceOp& reduceOp, TransformOp& transformOp, P... pointers)
+{
+    constexpr int NumAccumulators = 8;
+    if (n < 2 * NumAccumulators) {
+        return reduceSegment(std::false_type{}, n, result, reduceOp, transformOp, pointers...);
+    }
+    std::array<R, NumAccumulators> accumulators;
+    for (int k = 0; k < NumAccumulators; ++k) {
+        accumulators[static_cast<std::size_t>(k)] = transformOp(pointers[k]...);
+    }
+    offset_type i = NumAccumulators;
+    for (; i + NumAccumulators <= n; i += NumAccumulators) {
+        SLB_VECTORIZE_LOOP
+        for (int k = 0; k < NumAccumulators; ++k) {
+            accumulators[static_cast<std::size_t>(k)] = reduceOp(accumulators[static_cast<std::size_t>(k)], transformOp(pointers[i + k]...));
+        }
+    }
+    for (; i < n; ++i) {
+        accumulators[0] = reduceOp(accumulators[0], transformOp(pointers[i]...));
+    }
+    for (const R& accumulator : accumulators) {
+        result = reduceOp(result, accumulator);
+    }
+    return result;
+}
+
+template<class Mode, typename R, class ReduceOp, class TransformOp, class... Buffers>
+R transformReduce(const Mode& mode, R init, ReduceOp& reduceOp, TransformOp& transformOp, const Buffers&... buffers)
+{
+    auto segmentOp = [&](offset_type n, auto... pointers) {
+        init = reduceSegment(IsUnsequenced<Mode>{}, n, init, reduceOp, transformOp, pointers...);
+    };
+    forEachSegment(mode, segmentOp, buffers...);
+    return init;
+}
+
+/** Reduces the partitions on the threads of the pool (starting at their first element), then combines the results */
+template<typename R, class ReduceOp, class TransformOp, class... Buffers>
+R transformReduce(const Execution::Parallel& mode, R init, ReduceOp& reduceOp, TransformOp& transformOp, const Buffers&... buffers)
+{
+    std::array<R, MaxNumPartitions> partialResults;
+    std::array<bool, MaxNumPartitions> hasResult;
+    const int numPartitions = forEachPartition(mode, [&](int partition, auto forEachSegmentOfPartition) {
+        const std::size_t index = static_cast<std::size_t>(partition);
+        hasResult[index] = false;
+        auto segmentOp = [&](offset_type n, auto... pointers) {
+            if (n == 0) {
+                return;
+            }
+            if (!hasResult[index]) {
+                partialResults[index] = transformOp(pointers[0]...);
+                hasResult[index] = true;
+                partialResults[index] = reduceSegment(std::true_type{}, n - 1, partialResults[index], reduceOp, transformOp, (pointers + 1)...);
+            } else {
+                partialResults[index] = reduceSegment(std::true_type{}, n, partialResults[index], reduceOp, transformOp, pointers...);
+            }
+        };
+        forEachSegmentOfPartition(segmentOp);
+    }, buffers...);
+
+    for (std::size_t partition = 0; partition < static_cast<std::size_t>(numPartitions); ++partition) {
+        if (hasResult[partition]) {
+            init = reduceOp(init, partialResults[partition]);
+        }
+    }
+    return init;
+}
+
+/** The identity transformation for reduce() */
+struct Identity
+{
+    template<typename T> const T& operator()(const T& value) const noexcept { return value; }
+};
+} // namespace detail
+
+// MARK: - Element-wise
+
+/** Calls `function(element)` for every element of the buffer; the function may modify the element */
+template<class Mode, typename T, int N, class StoragePolicy, class Function>
+void forEach(const Mode& mode, HyperBuffer<T, N, StoragePolicy>& buffer, Function function)
+{
+    detail::forEachElement(mode, function, buffer);
+}
+
+template<class Mode, typename T, int N, class StoragePolicy, class Function>
+void forEach(const Mode& mode, const HyperBuffer<T, N, StoragePolicy>& buffer, Function function)
+{
+    detail::forEachElement(mode, function, buffer);
+}
+
+/** dst = op(src) (element-wise) */
+template<class Mode, typename T, typename U, int N, class StoragePolicy, class SrcStoragePolicy, class UnaryOp>
+void transform(const Mode& mode, HyperBuffer<T, N, StoragePolicy>& dst, const HyperBuffer<U, N, SrcStoragePolicy>& src, UnaryOp op)
+{
+    auto function = [&op](T& d, const U& s) { d = op(s); };
+    detail::forEachElement(mode, function, dst, src);
+}
+
+/** dst = op(a, b) (element-wise) */
+template<class Mode, typename T, typename U, typename V, int N, class StoragePolicy, class PolicyA, class PolicyB, class BinaryOp>
+void transform(const Mode& mode, HyperBuffer<T, N, StoragePolicy>& dst, const HyperBuffer<U, N, PolicyA>& a,
+               const HyperBuffer<V, N, PolicyB>& b, BinaryOp op)
+{
+    auto function = [&op](T& d, const U& x, const V& y) { d = op(x, y); };
+    detail::forEachElement(mode, function, dst, a, b);
+}
+
+/** dst = value (vectorized in every mode) */
+template<class Mode, typename T, int N, class StoragePolicy>
+void fill(const Mode& mode, HyperBuffer<T, N, StoragePolicy>& dst, BufferOperations::detail::non_deduced_t<T> value)
+{
+    auto segmentOp = [value](offset_type n, T* d) { SimdKernels::fill(d, value, n); };
+    detail::forEachSegment(mode, segmentOp, dst);
+}
+
+/** dst = src (vectorized in every mode) */
+template<class Mode, typename T, int N, class StoragePolicy, class SrcStoragePolicy>
+void copy(const Mode& mode, HyperBuffer<T, N, StoragePolicy>& dst, const HyperBuffer<T, N, SrcStoragePolicy>& src)
+{
+    auto segmentOp = [](offset_type n, T* d, const T* s) { SimdKernels::copy(d, s, n); };
+    detail::forEachSegment(mode, segmentOp, dst, src);
+}
+
+// MARK: - Reductions
+
+/**
+ * @returns init reduced with all elements by `reduceOp(accumulated, element)`. Except for Sequential, the order of
+ * the operations is unspecified: reduceOp has to be associative and commutative.
+ */
+template<class Mode, typename R, typename T, int N, class StoragePolicy, class ReduceOp>
+R reduce(const Mode& mode, const HyperBuffer<T, N, StoragePolicy>& buffer, R init, ReduceOp reduceOp)
+{
+    detail::Identity identity;
+    return detail::transformReduce(mode, init, reduceOp, identity, buffer);
+}
+
+/** @returns init reduced with `transformOp(element)` of all elements (@see reduce) */
+template<class Mode, typename R, typename T, int N, class StoragePolicy, class ReduceOp, class UnaryOp>
+R transformReduce(const Mode& mode, const HyperBuffer<T, N, StoragePolicy>& buffer, R init, ReduceOp reduceOp, UnaryOp transformOp)
+{
+    return detail::transformReduce(mode, init, reduceOp, transformOp, buffer);
+}
+
+/** @returns init reduced with `transformOp(a, b)` of all pairs of elements, e.g. the inner product (@see reduce) */
+template<class Mode, typename R, typename T, typename U, int N, class PolicyA, class PolicyB, class ReduceOp, class BinaryOp>
+R transformReduce(const Mode& mode, const HyperBuffer<T, N, PolicyA>& a, const HyperBuffer<U, N, PolicyB>& b, R init,
+                  ReduceOp reduceOp, BinaryOp transformOp)
+{
+    return detail::transformReduce(mode, init, reduceOp, transformOp, a, b);
+}
+
+} // namespace Algorithms
+} // namespace slb
@@ -0,0 +1,76 @@
+//
+//  ╦ ╦┬ ┬┌─┐┌─┐┬─┐  ╔╗ ┬ ┬┌─┐┌─┐┌─┐┬─┐
+//  ╠═╣└┬┘├─┘├┤ ├┬┘  ╠╩╗│ │├┤ ├┤ ├┤ ├┬┘
+//  ╩ ╩ ┴ ┴  └─┘┴└─  ╚═╝└─┘└  └  └─┘┴└─
+//
+//  © 2023 Lorenz Bucher - all rights reserved
+//  https://github.com/Sidelobe/HyperBuffer
+
+#pragma once
+
+#include <cstddef>
+#include <type_traits>
+
+#include "TemplateUtils.hpp"
+#include "MemoryResource.hpp"
+
+namespace slb
+{
+
+/**
+ *  STL-compatible allocator that returns memory aligned to a given number of bytes (at least alignof(T)).
+ *  The memory is drawn from a MemoryResource (by default: MemoryResources::getDefaultResource()).
+ *
+ *  Like std::pmr::polymorphic_allocator, the resource is kept when a container is copy-constructed or -assigned,
+ *  but it travels with the memory when a container is move-assigned (so moving never copies the elements).
+ *
+ *  - Template parameters: T=data type (e.g. float),  Alignment=alignment in bytes (power of two, e.g. 64)
+ */
+template<typename T, std::size_t Alignment = alignof(T)>
+class AlignedAllocator
+{
+    static_assert(AlignedMemory::isPowerOfTwo(Alignment), "Alignment must be a power of two");
+
+public:
+    using value_type = T;
+    static constexpr std::size_t alignment = (Alignment > alignof(T)) ? Alignment : alignof(T);
+    
+    using propagate_on_container_copy_assignment = std::false_type;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap = std::true_type;
+
+    template<typename U> struct rebind { using other = AlignedAllocator<U, Alignment>; };
+
+    AlignedAllocator() noexcept : m_resource(MemoryResources::getDefaultResource()) {}
+    AlignedAllocator(MemoryResource* resource) noexcept : m_resource(resource) { ASSERT(resource != nullptr); }
+    template<typename U> AlignedAllocator(const AlignedAllocator<U, Alignment>& other) noexcept : m_resource(other.getResource()) {}
+
+    T* allocate(std::size_t n)
+    {
+        return static_cast<T*>(m_resource->allocate(n * sizeof(T), alignment));
+    }
+
+    void deallocate(T* p, std::size_t n) noexcept
+    {
+        m_resource->deallocate(p, n * sizeof(T), alignment);
+    }
+    
+    MemoryResource* getResource() const noexcept { return m_resource; }
+    
+private:
+    MemoryResource* m_resource;
+};
+
+template<typename T, typename U, std::size_t Alignment>
+bool operator==(const AlignedAllocator<T, Alignment>& a, const AlignedAllocator<U, Alignment>& b) noexcept
+{
+    return *a.getResource() == *b.getResource();
+}
+
+template<typename T, typename U, std::size_t Alignment>
+bool operator!=(const AlignedAllocator<T, Alignment>& a, const AlignedAllocator<U, Alignment>& b) noexcept
+{
+    return !(a == b);
+}
+
+} // namespace slb
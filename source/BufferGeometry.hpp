@@ -10,6 +10,7 @@
 
 #include <memory>
 #include <array>
+#include <limits>
 
 #include "TemplateUtils.hpp"
 #include "IntArrayOperations.hpp"
@@ -23,6 +24,12 @@ namespace slb
  *
  * The underlying data model resembles two self-referencing flat (1D) arrays that contain all the pointers (for every
  * dimension except the lowest-order) and all the data (lowest-order dimension).
+ *
+ * The rows of the lowest-order dimension can optionally be padded (e.g. to preserve data alignment for every row):
+ * the 'innermost stride' is the distance between the starts of two consecutive rows in the data array.
+ *
+ * Array sizes, strides and offsets are of type offset_type (64-bit by default). They are computed once during
+ * construction, which fails if they exceed the range of offset_type.
  */
 template<int N>
 class BufferGeometry
@@ -30,47 +37,97 @@ class BufferGeometry
 public:
     /** Constructor that takes the extents of the dimensions as a variable argument list */
     template<typename... I>
-    explicit BufferGeometry(I... i) noexcept : m_dimensionExtents{i...}
+    explicit BufferGeometry(I... i) : m_dimensionExtents{i...}, m_innermostStride(m_dimensionExtents[N-1])
     {
         static_assert(sizeof...(I) == N, "Incorrect number of arguments");
+        computeStrides();
     }
     
     /** Constructor that takes the extents of the dimensions as a std::array */
-    explicit BufferGeometry(const std::array<int, N>& dimensionExtents) noexcept : m_dimensionExtents(dimensionExtents) {}
+    explicit BufferGeometry(const std::array<int, N>& dimensionExtents) :
+        m_dimensionExtents(dimensionExtents),
+        m_innermostStride(m_dimensionExtents[N-1])
+    {
+        computeStrides();
+    }
     
     /** Constructor that takes the extents of the dimensions as a std::vector */
     explicit BufferGeometry(const std::vector<int>& dimensionExtents)
     {
         ASSERT(dimensionExtents.size() == N, "Incorrect number of dimension extents");
         std::copy(dimensionExtents.begin(), dimensionExtents.end(), m_dimensionExtents.begin());
+        m_innermostStride = m_dimensionExtents[N-1];
+        computeStrides();
+    }
+    
+    /** Constructor that takes the extents of the dimensions as a std::array and pads the rows of the lowest-order
+     *  dimension to the given stride (number of elements from the start of one row to the next) */
+    BufferGeometry(const std::array<int, N>& dimensionExtents, int innermostStride) :
+        m_dimensionExtents(dimensionExtents),
+        m_innermostStride(innermostStride)
+    {
+        ASSERT(m_innermostStride >= m_dimensionExtents[N-1], "Stride must not be smaller than innermost extent");
+        computeStrides();
     }
 
     const std::array<int, N>& getDimensionExtents() const noexcept { return m_dimensionExtents; }
     const int* getDimensionExtentsPointer() const noexcept { return m_dimensionExtents.data(); }
     
+    /** @return the distance (in elements) between the starts of two consecutive rows of the lowest-order dimension */
+    int getInnermostStride() const noexcept { return m_innermostStride; }
+    
+    /** @return for every dimension, the distance (in elements) in the data array between two consecutive indices */
+    const std::array<offset_type, N>& getStrides() const noexcept { return m_strides; }
+    
+    /** @return true if the rows of the lowest-order dimension are padded, i.e. the data array contains gaps */
+    bool isPadded() const noexcept { return m_innermostStride != m_dimensionExtents[N-1]; }
+    
     /** @return the number of required data entries (lowest-order dimension) given the configured geometry */
-    int getRequiredDataArraySize() const noexcept
-    {
-        return StdArrayOperations::product(m_dimensionExtents);
-    }
+    offset_type getRequiredDataArraySize() const noexcept { return m_requiredDataArraySize; }
     
     /** @return the number of required pointer entries given the configured geometry */
-    int getRequiredPointerArraySize() const noexcept
-    {
-        return std::max(StdArrayOperations::sumOfCumulativeProductCapped(N-1, m_dimensionExtents), 1); // at least size 1
-    }
+    offset_type getRequiredPointerArraySize() const noexcept { return m_requiredPointerArraySize; }
     
     /**
      * Calculates the offset of where data that belongs to a specific (given index) highest-order sub-dimension starts.
      * e.g. if the highest-order dimension's extent is 2, all data for index=0 is located in the first half of
      * the **data** array and the all data for index=1 in the second half.
      */
-    int getDataArrayOffsetForHighestOrderSubDim(int index) const
+    offset_type getDataArrayOffsetForHighestOrderSubDim(int index) const
     {
-        const int totalNumDataEntries = getRequiredDataArraySize();
         ASSERT(index < m_dimensionExtents[0], "Index out of range");
-        ASSERT(totalNumDataEntries % m_dimensionExtents[0] == 0, "Internal error in buffer geometry!");
-        return index * totalNumDataEntries / m_dimensionExtents[0];
+        return index * m_strides[0];
+    }
+    
+    /**
+     * Calculates the offset of a single element in the data array, given one index per dimension.
+     * @note the indices are bounds-checked.
+     */
+    template<typename... I>
+    offset_type getDataArrayOffset(I... i) const
+    {
+        static_assert(sizeof...(I) == N, "Incorrect number of indices");
+        const int indices[] { static_cast<int>(i)... };
+        offset_type offset = 0;
+        for (int dim = 0; dim < N; ++dim) {
+            ASSERT(indices[dim] >= 0 && indices[dim] < m_dimensionExtents[dim], "Index out of range");
+            offset += indices[dim] * m_strides[dim];
+        }
+        return offset;
+    }
+    
+    /** @return a copy of this geometry whose rows are padded to a multiple of the given number of elements */
+    BufferGeometry<N> withAlignedRows(int rowAlignment) const
+    {
+        ASSERT(rowAlignment > 0, "Invalid row alignment");
+        const int paddedExtent = ((m_dimensionExtents[N-1] + rowAlignment - 1) / rowAlignment) * rowAlignment;
+        return BufferGeometry<N>(m_dimensionExtents, std::max(paddedExtent, m_innermostStride));
+    }
+    
+    /** @return the geometry of a highest-order sub-dimension (i.e. a N-1 geometry with identical padding) */
+    BufferGeometry<N-1> getSubDimGeometry() const
+    {
+        return BufferGeometry<N-1>(StdArrayOperations::shaveOffFirstElement(m_dimensionExtents), m_innermostStride);
     }
     
     /**
@@ -89,32 +146,88 @@ public:
         }
         
         // Intertwine pointer array: connect all pointers to itself -- skips 2 lowest-order dimensions
-        int dataPointerStartOffset = hookupHigherDimPointers(pointerArray, 0, 0);
+        offset_type dataPointerStartOffset = hookupHigherDimPointers(pointerArray, 0, 0);
   
         // Get number of data pointers (length of 2nd-lowest dim)
-        int numDataPointers = StdArrayOperations::productCapped(N-1, m_dimensionExtents);
+        offset_type numDataPointers = productOfExtents(N-1);
 
         // Hook up pointer that point to data (second lowest-order dimension)
-        for (int i=0; i < numDataPointers; ++i) {
-            int offsetInDataArray = i * m_dimensionExtents[N-1];
+        for (offset_type i=0; i < numDataPointers; ++i) {
+            offset_type offsetInDataArray = i * m_innermostStride;
             pointerArray[dataPointerStartOffset + i] = &dataArray[offsetInDataArray];
         }
     }
     
 private:
+    /** @returns a * b, asserting that the result fits into offset_type */
+    static offset_type multiplyChecked(offset_type a, offset_type b)
+    {
+        ASSERT(a <= 0 || b <= 0 || a <= std::numeric_limits<offset_type>::max() / b, "Buffer size exceeds the range of offset_type");
+        return a * b;
+    }
+    
+    /** @returns a + b, asserting that the result fits into offset_type */
+    static offset_type addChecked(offset_type a, offset_type b)
+    {
+        ASSERT(a <= 0 || b <= 0 || a <= std::numeric_limits<offset_type>::max() - b, "Buffer size exceeds the range of offset_type");
+        return a + b;
+    }
+    
+    /** @return the product of the extents of the `cap` highest-order dimensions */
+    offset_type productOfExtents(int cap) const noexcept
+    {
+        offset_type product = 1;
+        for (int dim = 0; dim < cap; ++dim) {
+            product *= m_dimensionExtents[dim];
+        }
+        return product;
+    }
+    
+    /** @return the number of pointers of all dimensions before the given one: sum of cumulative product capped */
+    offset_type sumOfCumulativeProductOfExtents(int cap) const noexcept
+    {
+        offset_type sum = 0;
+        for (int dim = 1; dim <= cap; ++dim) {
+            sum += productOfExtents(dim);
+        }
+        return sum;
+    }
+    
+    /**
+     * Pre-computes the strides of every dimension (taking into account the padding of the rows) and the required
+     * array sizes. Every product and sum is checked for overflow, so that the unchecked calculations that follow
+     * (offsets, hookup) stay within range.
+     */
+    void computeStrides()
+    {
+        m_strides[N-1] = 1;
+        for (int dim = N-2; dim >= 0; --dim) {
+            m_strides[dim] = (dim == N-2) ? m_innermostStride : multiplyChecked(m_strides[dim+1], m_dimensionExtents[dim+1]);
+        }
+        m_requiredDataArraySize = multiplyChecked(m_strides[0], (N == 1) ? m_innermostStride : m_dimensionExtents[0]);
+        
+        offset_type numPointers = 0;
+        offset_type numPointersInDimension = 1;
+        for (int dim = 0; dim < N-1; ++dim) {
+            numPointersInDimension = multiplyChecked(numPointersInDimension, m_dimensionExtents[dim]);
+            numPointers = addChecked(numPointers, numPointersInDimension);
+        }
+        m_requiredPointerArraySize = std::max(numPointers, offset_type{1}); // at least size 1
+    }
+    
     template<typename T, typename std::enable_if_t<!std::is_pointer<T>::value>* = nullptr>
-    int hookupHigherDimPointers(T** pointerArray, int arrayIndex, int dimIndex) const noexcept
+    offset_type hookupHigherDimPointers(T** pointerArray, offset_type arrayIndex, int dimIndex) const noexcept
     {
         if (dimIndex >= N-2) {
             return arrayIndex; // end recursion
         }
 
-        int startOfNextDimension = StdArrayOperations::sumOfCumulativeProductCapped(dimIndex+1, m_dimensionExtents);
-        int numPointersInThisDimension = StdArrayOperations::productCapped(dimIndex+1, m_dimensionExtents);
+        offset_type startOfNextDimension = sumOfCumulativeProductOfExtents(dimIndex+1);
+        offset_type numPointersInThisDimension = productOfExtents(dimIndex+1);
 
-        for (int index = 0; index < numPointersInThisDimension; ++index) {
-            int nextDimExtent = m_dimensionExtents[dimIndex + 1];
-            int offset = startOfNextDimension + nextDimExtent * index;
+        for (offset_type index = 0; index < numPointersInThisDimension; ++index) {
+            offset_type nextDimExtent = m_dimensionExtents[dimIndex + 1];
+            offset_type offset = startOfNextDimension + nextDimExtent * index;
             // hook up pointer to element of next dimension
             pointerArray[arrayIndex + index] = reinterpret_cast<T*>(&pointerArray[offset]);
         }
@@ -126,7 +239,93 @@ private:
                                                      
 private:
     std::array<int, N> m_dimensionExtents;
+    int m_innermostStride;
+    std::array<offset_type, N> m_strides;
+    offset_type m_requiredDataArraySize;
+    offset_type m_requiredPointerArraySize;
+};
+
+// ====================================================================================================================
+namespace detail
+{
+/** @returns the strides of a (non-padded) geometry with the given extents */
+template<int... Extents, std::size_t... I>
+constexpr std::array<offset_type, sizeof...(Extents)> makeStaticStrides(std::index_sequence<I...>) noexcept
+{
+    constexpr int N = sizeof...(Extents);
+    return {{ (static_cast<int>(I) == N-1) ? 1 : CompiletimeMath::productOverRange(static_cast<int>(I)+2, N-static_cast<int>(I)-1,
+                                                                                   static_cast<offset_type>(Extents)...)... }};
+}
+} // namespace detail
+
+/**
+ * Compile-time counterpart of BufferGeometry: the extents of the dimensions are template parameters, so that all
+ * the geometry calculations (array sizes, strides, offsets) are resolved at compile time. Rows are never padded.
+ */
+template<int... Extents>
+class StaticBufferGeometry
+{
+public:
+    static constexpr int N = sizeof...(Extents);
+    static_assert(N > 0, "At least one dimension is required");
+    
+    static constexpr std::array<int, N> DimensionExtents {{ Extents... }};
+    static constexpr std::array<offset_type, N> Strides = detail::makeStaticStrides<Extents...>(std::make_index_sequence<N>{});
+    
+    static constexpr const std::array<int, N>& getDimensionExtents() noexcept { return DimensionExtents; }
+    static constexpr const std::array<offset_type, N>& getStrides() noexcept { return Strides; }
+    static constexpr int getInnermostStride() noexcept { return DimensionExtents[N-1]; }
+    static constexpr bool isPadded() noexcept { return false; }
+    
+    /** @see BufferGeometry::getRequiredDataArraySize */
+    static constexpr offset_type getRequiredDataArraySize() noexcept
+    {
+        return CompiletimeMath::product(static_cast<offset_type>(Extents)...);
+    }
+    
+    /** @see BufferGeometry::getRequiredPointerArraySize */
+    static constexpr offset_type getRequiredPointerArraySize() noexcept
+    {
+        return std::max(CompiletimeMath::sumOfCumulativeProductCapped(N-1, static_cast<offset_type>(Extents)...), offset_type{1}); // at least size 1
+    }
+    
+    /** @see BufferGeometry::getDataArrayOffsetForHighestOrderSubDim */
+    static constexpr offset_type getDataArrayOffsetForHighestOrderSubDim(int index)
+    {
+        ASSERT(index < DimensionExtents[0], "Index out of range");
+        return index * Strides[0];
+    }
+    
+    /** @see BufferGeometry::getDataArrayOffset */
+    template<typename... I>
+    static constexpr offset_type getDataArrayOffset(I... i)
+    {
+        static_assert(sizeof...(I) == N, "Incorrect number of indices");
+        const int indices[] { static_cast<int>(i)... };
+        offset_type offset = 0;
+        for (int dim = 0; dim < N; ++dim) {
+            ASSERT(indices[dim] >= 0 && indices[dim] < DimensionExtents[dim], "Index out of range");
+            offset += indices[dim] * Strides[dim];
+        }
+        return offset;
+    }
+    
+    /** @return the (runtime) geometry of a highest-order sub-dimension */
+    static BufferGeometry<N-1> getSubDimGeometry()
+    {
+        return BufferGeometry<N-1>(StdArrayOperations::shaveOffFirstElement(DimensionExtents));
+    }
     
+    /** @see BufferGeometry::hookupPointerArrayToData */
+    template<typename T, typename std::enable_if_t<!std::is_pointer<T>::value>* = nullptr>
+    static void hookupPointerArrayToData(T* dataArray, T** pointerArray)
+    {
+        BufferGeometry<N>(DimensionExtents).hookupPointerArrayToData(dataArray, pointerArray);
+    }
 };
 
+// Definitions of the static members (required if they are odr-used, pre-C++17)
+template<int... Extents> constexpr std::array<int, StaticBufferGeometry<Extents...>::N> StaticBufferGeometry<Extents...>::DimensionExtents;
+template<int... Extents> constexpr std::array<offset_type, StaticBufferGeometry<Extents...>::N> StaticBufferGeometry<Extents...>::Strides;
+
 } // namespace slb
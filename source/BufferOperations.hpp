@@ -0,0 +1,216 @@
+//
+//  ╦ ╦┬ ┬┌─┐┌─┐┬─┐  ╔╗ ┬ ┬┌─┐┌─┐┌─┐┬─┐
+//  ╠═╣└┬┘├─┘├┤ ├┬┘  ╠╩╗│ │├┤ ├┤ ├┤ ├┬┘
+//  ╩ ╩ ┴ ┴  └─┘┴└─  ╚═╝└─┘└  └  └─┘┴└─
+//
+//  © 2023 Lorenz Bucher - all rights reserved
+//  https://github.com/Sidelobe/HyperBuffer
+
+#pragma once
+
+#include <array>
+#include <type_traits>
+
+#include "TemplateUtils.hpp"
+#include "IntArrayOperations.hpp"
+#include "SimdKernels.hpp"
+
+namespace slb
+{
+
+template<typename T, int N, class StoragePolicy> class HyperBuffer; // forward declaration
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Element-wise bulk operations on whole HyperBuffers (or sub-views thereof), vectorized with SimdKernels.
+//
+// Buffers whose data is one contiguous, unpadded block are processed in a single pass over the flat data; all others
+// (padded rows, non-contiguous views) are processed row by row (lowest-order dimension). The extents of all buffers
+// involved in an operation have to match. No operation allocates memory.
+// ---------------------------------------------------------------------------------------------------------------------
+namespace BufferOperations
+{
+namespace detail
+{
+/** Prevents a function argument from taking part in template argument deduction (e.g. `fill(floatBuffer, 0)`) */
+template<typename T> struct NonDeduced { using type = T; };
+template<typename T> using non_deduced_t = typename NonDeduced<T>::type;
+
+/** @returns the address of the first element of a (multi-dimensional) raw pointer structure */
+template<typename P>
+auto firstElement(P data, std::false_type /*points to pointers*/) noexcept { return data; }
+
+template<typename P>
+auto firstElement(P pointers, std::true_type /*points to pointers*/) noexcept
+{
+    return firstElement(*pointers, std::is_pointer<std::remove_pointer_t<std::decay_t<decltype(*pointers)>>>{});
+}
+
+template<typename P>
+auto firstElement(P pointers) noexcept { return firstElement(pointers, std::is_pointer<std::remove_pointer_t<P>>{}); }
+
+/** @returns true if the buffer's data is a single, unpadded block of memory */
+template<typename T, int N, class StoragePolicy>
+bool isFlat(const HyperBuffer<T, N, StoragePolicy>& buffer, std::true_type /*contiguous*/) noexcept
+{
+    return buffer.stridedView().isContiguous();
+}
+
+template<typename T, int N, class StoragePolicy>
+bool isFlat(const HyperBuffer<T, N, StoragePolicy>&, std::false_type /*contiguous*/) noexcept
+{
+    return false;
+}
+
+template<typename T, int N, class StoragePolicy>
+bool isFlat(const HyperBuffer<T, N, StoragePolicy>& buffer) noexcept
+{
+    return isFlat(buffer, std::integral_constant<bool, StoragePolicy::IsContiguous>{});
+}
+
+inline bool areAllFlat() noexcept { return true; }
+
+template<class Buffer, class... Buffers>
+bool areAllFlat(const Buffer& first, const Buffers&... others) noexcept
+{
+    return isFlat(first) && areAllFlat(others...);
+}
+
+template<int N>
+bool haveSizes(const std::array<int, N>&) noexcept { return true; }
+
+template<int N, class Buffer, class... Buffers>
+bool haveSizes(const std::array<int, N>& sizes, const Buffer& first, const Buffers&... others) noexcept
+{
+    return first.sizes() == sizes && haveSizes<N>(sizes, others...);
+}
+
+/** @returns the number of elements of the given extents, computed in offset_type */
+template<std::size_t N>
+offset_type numElements(const std::array<int, N>& sizes) noexcept
+{
+    offset_type count = 1;
+    for (int extent : sizes) {
+        count *= extent;
+    }
+    return count;
+}
+
+/** Recursion through the pointer structures of all buffers at once, down to the rows of the lowest-order dimension */
+template<class RowOp, typename... Rows>
+void forEachRow(std::integral_constant<int, 1>, const int* extents, RowOp& rowOp, Rows... rows)
+{
+    rowOp(extents[0], rows...);
+}
+
+template<int D, class RowOp, typename... Pointers>
+void forEachRow(std::integral_constant<int, D>, const int* extents, RowOp& rowOp, Pointers... pointers)
+{
+    for (int i = 0; i < extents[0]; ++i) {
+        forEachRow(std::integral_constant<int, D-1>{}, extents + 1, rowOp, pointers[i]...);
+    }
+}
+
+/**
+ * Calls `rowOp(length, dstRow, sourceRows...)` for every row of the destination and the corresponding rows of the
+ * source buffers -- or just once, with all elements, if all of them are flat.
+ */
+template<typename T, int N, class StoragePolicy, class RowOp, class... Sources>
+void forEachRow(RowOp rowOp, HyperBuffer<T, N, StoragePolicy>& dst, const Sources&... sources)
+{
+    ASSERT(haveSizes<N>(dst.sizes(), sources...), "Extents of the buffers do not match");
+    if (areAllFlat(dst, sources...)) {
+        rowOp(numElements(dst.sizes()), firstElement(dst.data()), firstElement(sources.data())...);
+    } else {
+        forEachRow(std::integral_constant<int, N>{}, dst.sizes().data(), rowOp, dst.data(), sources.data()...);
+    }
+}
+} // namespace detail
+
+/** dst = value */
+template<typename T, int N, class StoragePolicy>
+void fill(HyperBuffer<T, N, StoragePolicy>& dst, detail::non_deduced_t<T> value)
+{
+    detail::forEachRow([value](offset_type n, T* d) { SimdKernels::fill(d, value, n); }, dst);
+}
+
+/** dst = src */
+template<typename T, int N, class StoragePolicy, class SrcStoragePolicy>
+void copy(HyperBuffer<T, N, StoragePolicy>& dst, const HyperBuffer<T, N, SrcStoragePolicy>& src)
+{
+    detail::forEachRow([](offset_type n, T* d, const T* s) { SimdKernels::copy(d, s, n); }, dst, src);
+}
+
+/** dst += src */
+template<typename T, int N, class StoragePolicy, class SrcStoragePolicy>
+void add(HyperBuffer<T, N, StoragePolicy>& dst, const HyperBuffer<T, N, SrcStoragePolicy>& src)
+{
+    detail::forEachRow([](offset_type n, T* d, const T* s) { SimdKernels::add(d, s, n); }, dst, src);
+}
+
+/** dst -= src */
+template<typename T, int N, class StoragePolicy, class SrcStoragePolicy>
+void subtract(HyperBuffer<T, N, StoragePolicy>& dst, const HyperBuffer<T, N, SrcStoragePolicy>& src)
+{
+    detail::forEachRow([](offset_type n, T* d, const T* s) { SimdKernels::subtract(d, s, n); }, dst, src);
+}
+
+/** dst *= src (element-wise) */
+template<typename T, int N, class StoragePolicy, class SrcStoragePolicy>
+void multiply(HyperBuffer<T, N, StoragePolicy>& dst, const HyperBuffer<T, N, SrcStoragePolicy>& src)
+{
+    detail::forEachRow([](offset_type n, T* d, const T* s) { SimdKernels::multiply(d, s, n); }, dst, src);
+}
+
+/** dst *= gain */
+template<typename T, int N, class StoragePolicy>
+void scale(HyperBuffer<T, N, StoragePolicy>& dst, detail::non_deduced_t<T> gain)
+{
+    detail::forEachRow([gain](offset_type n, T* d) { SimdKernels::scale(d, gain, n); }, dst);
+}
+
+/** dst += src * gain */
+template<typename T, int N, class StoragePolicy, class SrcStoragePolicy>
+void multiplyAccumulate(HyperBuffer<T, N, StoragePolicy>& dst, const HyperBuffer<T, N, SrcStoragePolicy>& src,
+                        detail::non_deduced_t<T> gain)
+{
+    detail::forEachRow([gain](offset_type n, T* d, const T* s) { SimdKernels::multiplyAccumulate(d, s, gain, n); }, dst, src);
+}
+
+/** dst += a * b (element-wise) */
+template<typename T, int N, class StoragePolicy, class PolicyA, class PolicyB>
+void multiplyAccumulate(HyperBuffer<T, N, StoragePolicy>& dst, const HyperBuffer<T, N, PolicyA>& a,
+                        const HyperBuffer<T, N, PolicyB>& b)
+{
+    detail::forEachRow([](offset_type n, T* d, const T* x, const T* y) { SimdKernels::multiplyAccumulate(d, x, y, n); }, dst, a, b);
+}
+
+/** dst = min(max(dst, low), high) */
+template<typename T, int N, class StoragePolicy>
+void clamp(HyperBuffer<T, N, StoragePolicy>& dst, detail::non_deduced_t<T> low, detail::non_deduced_t<T> high)
+{
+    ASSERT(!(high < low), "Invalid clamping range");
+    detail::forEachRow([low, high](offset_type n, T* d) { SimdKernels::clamp(d, low, high, n); }, dst);
+}
+
+/**
+ * dst[ch][i] = interleaved[i * numChannels + ch]: splits a stream of interleaved frames (e.g. LRLRLR...) into the
+ * channels of a [channel][frame] buffer. The stream has to contain dst.size(1) frames of dst.size(0) channels.
+ */
+template<typename T, class StoragePolicy>
+void deinterleave(HyperBuffer<T, 2, StoragePolicy>& dst, const T* interleaved)
+{
+    SimdKernels::deinterleave(dst.data(), interleaved, dst.size(0), dst.size(1));
+}
+
+/**
+ * interleaved[i * numChannels + ch] = src[ch][i]: merges the channels of a [channel][frame] buffer into a stream of
+ * interleaved frames, which has to hold src.size(1) frames of src.size(0) channels.
+ */
+template<typename T, class StoragePolicy>
+void interleave(T* interleaved, const HyperBuffer<T, 2, StoragePolicy>& src)
+{
+    SimdKernels::interleave(interleaved, src.data(), src.size(0), src.size(1));
+}
+
+} // namespace BufferOperations
+} // namespace slb
@@ -0,0 +1,370 @@
+//
+//  ╦ ╦┬ ┬┌─┐┌─┐┬─┐  ╔╗ ┬ ┬┌─┐┌─┐┌─┐┬─┐
+//  ╠═╣└┬┘├─┘├┤ ├┬┘  ╠╩╗│ │├┤ ├┤ ├┤ ├┬┘
+//  ╩ ╩ ┴ ┴  └─┘┴└─  ╚═╝└─┘└  └  └─┘┴└─
+//
+//  © 2023 Lorenz Bucher - all rights reserved
+//  https://github.com/Sidelobe/HyperBuffer
+
+#pragma once
+
+#include <array>
+#include <type_traits>
+
+#include "HyperBuffer.hpp"
+
+namespace slb
+{
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Expression templates: element-wise arithmetic on buffers (+, -, *, unary -, min, max) with buffers or scalars as
+// operands creates a lazy expression object. Assigning it to a buffer evaluates the entire expression in a single pass
+// over the data, without temporary buffers:
+//
+//     mix = left * gainLeft + right * gainRight;   // one pass, vectorized for float and double
+//
+// - the operands have to have the same dimension N (checked at compile time) and extents (checked at runtime), and
+//   the same data type (scalars are converted)
+// - buffers of any storage policy and strided views can be combined: flat data is evaluated in one go, everything
+//   else row by row. Broadcast views (@see StridedView::broadcast) apply e.g. a gain per channel without a copy:
+//   `out = in * gains.broadcast<2>({ numChannels, numSamples }, { 0 })`
+// - the expression refers to its buffer operands: it has to be assigned in the same statement, not stored with `auto`
+// - the destination may be an operand (e.g. `a = a * 0.5f + b`), but must not overlap with an operand otherwise
+// ---------------------------------------------------------------------------------------------------------------------
+namespace Expressions
+{
+/** Element-wise operations, on scalars and on SIMD packs */
+struct Add
+{
+    template<typename T> static T apply(T a, T b) noexcept { return a + b; }
+    template<class P, typename R> static R apply(P, R a, R b) noexcept { return P::add(a, b); }
+};
+
+struct Subtract
+{
+    template<typename T> static T apply(T a, T b) noexcept { return a - b; }
+    template<class P, typename R> static R apply(P, R a, R b) noexcept { return P::sub(a, b); }
+};
+
+struct Multiply
+{
+    template<typename T> static T apply(T a, T b) noexcept { return a * b; }
+    template<class P, typename R> static R apply(P, R a, R b) noexcept { return P::mul(a, b); }
+};
+
+struct Minimum
+{
+    template<typename T> static T apply(T a, T b) noexcept { return SimdKernels::detail::min(a, b); }
+    template<class P, typename R> static R apply(P, R a, R b) noexcept { return P::min(a, b); }
+};
+
+struct Maximum
+{
+    template<typename T> static T apply(T a, T b) noexcept { return SimdKernels::detail::max(a, b); }
+    template<class P, typename R> static R apply(P, R a, R b) noexcept { return P::max(a, b); }
+};
+
+// MARK: segments -- the evaluation of a node for a contiguous range of elements (a row, or all flat data)
+
+template<typename T>
+struct DataSegment
+{
+    const T* data;
+    T operator[](offset_type i) const noexcept { return data[i]; }
+    template<class P> auto load(P, offset_type i) const noexcept { return P::load(data + i); }
+};
+
+/** Elements at a distance of `stride` - 0 for broadcast data */
+template<typename T>
+struct StridedSegment
+{
+    const T* data;
+    offset_type stride;
+    T operator[](offset_type i) const noexcept { return data[i * stride]; }
+    template<class P> auto load(P, offset_type i) const noexcept
+    {
+        if (stride == 1) {
+            return P::load(data + i);
+        }
+        if (stride == 0) {
+            return P::broadcast(*data);
+        }
+        T gathered[P::Width];
+        for (int k = 0; k < P::Width; ++k) {
+            gathered[k] = data[(i + k) * stride];
+        }
+        return P::load(gathered);
+    }
+};
+
+template<typename T>
+struct ScalarSegment
+{
+    T value;
+    T operator[](offset_type /*i*/) const noexcept { return value; }
+    template<class P> auto load(P, offset_type /*i*/) const noexcept { return P::broadcast(value); }
+};
+
+template<class Op, class LeftSegment, class RightSegment>
+struct BinarySegment
+{
+    LeftSegment left;
+    RightSegment right;
+    auto operator[](offset_type i) const noexcept { return Op::apply(left[i], right[i]); }
+    template<class P> auto load(P p, offset_type i) const noexcept { return Op::apply(p, left.load(p, i), right.load(p, i)); }
+};
+} // namespace Expressions
+
+// MARK: - Expression nodes
+
+/** Leaf of an expression: refers to a buffer */
+template<typename T, int N, class StoragePolicy>
+class ExpressionTerminal
+{
+public:
+    using value_type = T;
+    static constexpr int Dimensions = N;
+    static constexpr bool IsScalar = false;
+
+    explicit ExpressionTerminal(const HyperBuffer<T, N, StoragePolicy>& buffer) noexcept : m_buffer(buffer) {}
+
+    const std::array<int, N>& sizes() const noexcept { return m_buffer.sizes(); }
+    bool isFlat() const noexcept { return N == 1 || BufferOperations::detail::isFlat(m_buffer); }
+
+    Expressions::DataSegment<T> getFlatSegment() const noexcept { return { BufferOperations::detail::firstElement(m_buffer.data()) }; }
+    Expressions::DataSegment<T> getSegment(offset_type rowIndex) const noexcept
+    {
+        return { detail::getRowPointer(std::integral_constant<int, N>{}, m_buffer.data(), sizes().data(), rowIndex) };
+    }
+
+private:
+    const HyperBuffer<T, N, StoragePolicy>& m_buffer;
+};
+
+/** Leaf of an expression: refers to the data of a strided view, e.g. a broadcast or a slice */
+template<typename T, int N>
+class ExpressionStridedTerminal
+{
+public:
+    using value_type = T;
+    static constexpr int Dimensions = N;
+    static constexpr bool IsScalar = false;
+
+    explicit ExpressionStridedTerminal(const StridedView<const T, N>& view) noexcept : m_view(view) {}
+
+    const std::array<int, N>& sizes() const noexcept { return m_view.sizes(); }
+    bool isFlat() const noexcept { return m_view.isContiguous(); }
+
+    /** Contiguous data: all elements at a distance of 1 (the stride of dimensions with extent 1 is irrelevant) */
+    Expressions::StridedSegment<T> getFlatSegment() const noexcept { return { m_view.data(), 1 }; }
+    Expressions::StridedSegment<T> getSegment(offset_type rowIndex) const noexcept
+    {
+        offset_type offset = 0;
+        for (int dim = N-2; dim >= 0; --dim) {
+            offset += (rowIndex % m_view.size(dim)) * m_view.stride(dim);
+            rowIndex /= m_view.size(dim);
+        }
+        return { m_view.data() + offset, m_view.stride(N-1) };
+    }
+
+private:
+    StridedView<const T, N> m_view;
+};
+
+/** Leaf of an expression: a scalar value, which is applied to all elements */
+template<typename T>
+class ExpressionScalar
+{
+public:
+    using value_type = T;
+    static constexpr bool IsScalar = true;
+
+    explicit ExpressionScalar(T value) noexcept : m_value(value) {}
+
+    bool isFlat() const noexcept { return true; }
+    Expressions::ScalarSegment<T> getFlatSegment() const noexcept { return { m_value }; }
+    Expressions::ScalarSegment<T> getSegment(offset_type /*rowIndex*/) const noexcept { return { m_value }; }
+
+private:
+    T m_value;
+};
+
+/** Element-wise operation on two sub-expressions (at most one of them a scalar) */
+template<class Op, class Left, class Right>
+class ExpressionBinary
+{
+    using Sized = std::conditional_t<Left::IsScalar, Right, Left>;
+
+public:
+    using value_type = typename Left::value_type;
+    static constexpr int Dimensions = Sized::Dimensions;
+    static constexpr bool IsScalar = false;
+    static constexpr bool IsExpression = true;
+
+    static_assert(std::is_same<value_type, typename Right::value_type>::value, "Operands must have the same data type");
+
+    ExpressionBinary(const Left& left, const Right& right) : m_left(left), m_right(right)
+    {
+        checkSizes(std::integral_constant<bool, (Left::IsScalar || Right::IsScalar)>{});
+    }
+
+    const std::array<int, Dimensions>& sizes() const noexcept { return getSized(std::integral_constant<bool, Left::IsScalar>{}).sizes(); }
+    bool isFlat() const noexcept { return m_left.isFlat() && m_right.isFlat(); }
+
+    auto getFlatSegment() const noexcept
+    {
+        using Segment = Expressions::BinarySegment<Op, decltype(m_left.getFlatSegment()), decltype(m_right.getFlatSegment())>;
+        return Segment { m_left.getFlatSegment(), m_right.getFlatSegment() };
+    }
+    auto getSegment(offset_type rowIndex) const noexcept
+    {
+        using Segment = Expressions::BinarySegment<Op, decltype(m_left.getSegment(rowIndex)), decltype(m_right.getSegment(rowIndex))>;
+        return Segment { m_left.getSegment(rowIndex), m_right.getSegment(rowIndex) };
+    }
+
+private:
+    void checkSizes(std::true_type /*scalar operand*/) const noexcept {}
+    void checkSizes(std::false_type /*scalar operand*/) const
+    {
+        static_assert(Left::Dimensions == Right::Dimensions, "Operands must have the same number of dimensions");
+        ASSERT(m_left.sizes() == m_right.sizes(), "Extents of the operands do not match");
+    }
+
+    const Right& getSized(std::true_type /*left is scalar*/) const noexcept { return m_right; }
+    const Left& getSized(std::false_type /*left is scalar*/) const noexcept { return m_left; }
+
+    Left m_left;
+    Right m_right;
+};
+
+// MARK: - Operands
+
+namespace Expressions
+{
+/** Wraps the operands of the operators in expression nodes: buffers become terminals, expressions stay as they are */
+template<class T>
+struct Operand
+{
+    static constexpr bool IsValid = false;
+};
+
+template<typename T, int N, class StoragePolicy>
+struct Operand<HyperBuffer<T, N, StoragePolicy>>
+{
+    static constexpr bool IsValid = true;
+    using value_type = T;
+    using Node = ExpressionTerminal<T, N, StoragePolicy>;
+    static Node wrap(const HyperBuffer<T, N, StoragePolicy>& buffer) noexcept { return Node(buffer); }
+};
+
+template<typename T, int N>
+struct Operand<StridedView<T, N>>
+{
+    static constexpr bool IsValid = true;
+    using value_type = std::remove_const_t<T>;
+    using Node = ExpressionStridedTerminal<value_type, N>;
+    static Node wrap(const StridedView<T, N>& view) noexcept { return Node(view); }
+};
+
+template<class Op, class Left, class Right>
+struct Operand<ExpressionBinary<Op, Left, Right>>
+{
+    static constexpr bool IsValid = true;
+    using value_type = typename ExpressionBinary<Op, Left, Right>::value_type;
+    using Node = ExpressionBinary<Op, Left, Right>;
+    static const Node& wrap(const Node& expression) noexcept { return expression; }
+};
+
+template<class A, class B = A>
+using EnableIfOperands = std::enable_if_t<Operand<A>::IsValid && Operand<B>::IsValid, int>;
+
+template<class Op, class A, class B>
+auto combine(const A& a, const B& b)
+{
+    using Left = typename Operand<A>::Node;
+    using Right = typename Operand<B>::Node;
+    return ExpressionBinary<Op, Left, Right>(Operand<A>::wrap(a), Operand<B>::wrap(b));
+}
+
+template<class Op, class A>
+auto combineWithScalar(const A& a, typename Operand<A>::value_type scalar)
+{
+    using Left = typename Operand<A>::Node;
+    using Right = ExpressionScalar<typename Operand<A>::value_type>;
+    return ExpressionBinary<Op, Left, Right>(Operand<A>::wrap(a), Right(scalar));
+}
+
+template<class Op, class B>
+auto combineWithScalar(typename Operand<B>::value_type scalar, const B& b)
+{
+    using Left = ExpressionScalar<typename Operand<B>::value_type>;
+    using Right = typename Operand<B>::Node;
+    return ExpressionBinary<Op, Left, Right>(Left(scalar), Operand<B>::wrap(b));
+}
+} // namespace Expressions
+
+// MARK: - Operators
+
+template<class A, class B, Expressions::EnableIfOperands<A, B> = 0>
+auto operator+(const A& a, const B& b) { return Expressions::combine<Expressions::Add>(a, b); }
+template<class A, Expressions::EnableIfOperands<A> = 0>
+auto operator+(const A& a, typename Expressions::Operand<A>::value_type b) { return Expressions::combineWithScalar<Expressions::Add, A>(a, b); }
+template<class B, Expressions::EnableIfOperands<B> = 0>
+auto operator+(typename Expressions::Operand<B>::value_type a, const B& b) { return Expressions::combineWithScalar<Expressions::Add, B>(a, b); }
+
+template<class A, class B, Expressions::EnableIfOperands<A, B> = 0>
+auto operator-(const A& a, const B& b) { return Expressions::combine<Expressions::Subtract>(a, b); }
+template<class A, Expressions::EnableIfOperands<A> = 0>
+auto operator-(const A& a, typename Expressions::Operand<A>::value_type b) { return Expressions::combineWithScalar<Expressions::Subtract, A>(a, b); }
+template<class B, Expressions::EnableIfOperands<B> = 0>
+auto operator-(typename Expressions::Operand<B>::value_type a, const B& b) { return Expressions::combineWithScalar<Expressions::Subtract, B>(a, b); }
+template<class A, Expressions::EnableIfOperands<A> = 0>
+auto operator-(const A& a) { return Expressions::combineWithScalar<Expressions::Subtract, A>(typename Expressions::Operand<A>::value_type(0), a); }
+
+template<class A, class B, Expressions::EnableIfOperands<A, B> = 0>
+auto operator*(const A& a, const B& b) { return Expressions::combine<Expressions::Multiply>(a, b); }
+template<class A, Expressions::EnableIfOperands<A> = 0>
+auto operator*(const A& a, typename Expressions::Operand<A>::value_type b) { return Expressions::combineWithScalar<Expressions::Multiply, A>(a, b); }
+template<class B, Expressions::EnableIfOperands<B> = 0>
+auto operator*(typename Expressions::Operand<B>::value_type a, const B& b) { return Expressions::combineWithScalar<Expressions::Multiply, B>(a, b); }
+
+/** Element-wise minimum of two operands (or of an operand and a scalar) */
+template<class A, class B, Expressions::EnableIfOperands<A, B> = 0>
+auto min(const A& a, const B& b) { return Expressions::combine<Expressions::Minimum>(a, b); }
+template<class A, Expressions::EnableIfOperands<A> = 0>
+auto min(const A& a, typename Expressions::Operand<A>::value_type b) { return Expressions::combineWithScalar<Expressions::Minimum, A>(a, b); }
+
+/** Element-wise maximum of two operands (or of an operand and a scalar) */
+template<class A, class B, Expressions::EnableIfOperands<A, B> = 0>
+auto max(const A& a, const B& b) { return Expressions::combine<Expressions::Maximum>(a, b); }
+template<class A, Expressions::EnableIfOperands<A> = 0>
+auto max(const A& a, typename Expressions::Operand<A>::value_type b) { return Expressions::combineWithScalar<Expressions::Maximum, A>(a, b); }
+
+// MARK: - Evaluation
+
+/** dst = expression: evaluates the expression for all elements in a single pass (called by HyperBuffer::operator=) */
+template<typename T, int N, class StoragePolicy, class Expression>
+void evaluateExpression(HyperBuffer<T, N, StoragePolicy>& dst, const Expression& expression)
+{
+    static_assert(Expression::Dimensions == N, "Expression must have the same number of dimensions");
+    static_assert(std::is_same<typename Expression::value_type, T>::value, "Expression must have the same data type");
+    ASSERT(dst.sizes() == expression.sizes(), "Extents of the expression do not match");
+
+    auto evaluateSegment = [](offset_type n, T* d, const auto& segment) {
+        SimdKernels::detail::forEachIndex<T>(n,
+            [&](auto p, offset_type i) { using P = decltype(p); P::store(d + i, segment.load(p, i)); },
+            [&](offset_type i) { d[i] = segment[i]; });
+    };
+    if (BufferOperations::detail::isFlat(dst) && expression.isFlat()) {
+        evaluateSegment(BufferOperations::detail::numElements(dst.sizes()), BufferOperations::detail::firstElement(dst.data()),
+                        expression.getFlatSegment());
+        return;
+    }
+    const offset_type numRows = BufferOperations::detail::numElements(dst.sizes()) / dst.size(N-1);
+    for (offset_type row = 0; row < numRows; ++row) {
+        T* dstRow = detail::getRowPointer(std::integral_constant<int, N>{}, dst.data(), dst.sizes().data(), row);
+        evaluateSegment(dst.size(N-1), dstRow, expression.getSegment(row));
+    }
+}
+
+} // namespace slb
@@ -9,6 +9,9 @@
 #pragma once
 
 #include "HyperBufferStoragePolicies.hpp"
+#include "StridedView.hpp"
+#include "HyperBufferIterators.hpp"
+#include "BufferOperations.hpp"
 
 // Macros to restrict a function declaration to certain use cases, e.g. 1-dimensional, higher-dimensional, ...
 #define FOR_N1 template<int M=N, std::enable_if_t<(M==1), int> = 0>
@@ -28,10 +31,17 @@ namespace slb
  *  - Template parameters: T=data type (e.g. float),  N=dimension (e.g. 3),
  *    StoragePolicy:
  *      -# 'Owning' (default): uses the native memory model and has full ownership of the multi-dimensional data
+ *      -# 'Owning Single-Block': same as 'owning', but pointers and data share a single allocation
  *      -# 'View': same memory model as 'owning', but without ownership: uses an externally-allocated 1-D data block
  *      -# 'Non-Contiguous View': uses externally-allocated non-contiguously allocated data
+ *      -# 'Sub-View': view to a sub-dimension of an 'Owning' or a 'View' - borrows the parent's pointers and data
+ *      -# 'Static': extents are template parameters; data and pointers are stored inline (no dynamic allocation)
+ *      -# 'Mapped': the data is a memory-mapped file, pointers are owned (@see HyperBufferMapped.hpp)
  *
- *  - Guarantees: Dynamic memory allocation only during construction and when calling subView()
+ *  - Guarantees: Dynamic memory allocation only during construction (sub-views and at() never allocate)
+ *
+ *  - Memory: 'Owning', 'Owning Single-Block' and 'View' draw their memory from a MemoryResource, which can be passed
+ *    as the first constructor argument, e.g. HyperBuffer<float, 2> buffer(&arena, 2, 512);
  */
 template<typename T, int N, class StoragePolicy = StoragePolicyOwning<T, N>>
 class HyperBuffer
@@ -41,6 +51,7 @@ class HyperBuffer
     using const_pointer_type        = typename add_const_pointers_to_type<T, N>::type;
     using subdim_pointer_type       = typename remove_pointers_from_type<pointer_type, 1>::type;
     using subdim_const_pointer_type = typename remove_pointers_from_type<const_pointer_type, 1>::type;
+    using is_contiguous             = std::integral_constant<bool, StoragePolicy::IsContiguous>;
     
 public:
     /** Generic Constructor that forwards all arguments to the storage policy constructor */
@@ -55,6 +66,14 @@ public:
     HyperBuffer(HyperBuffer&&) noexcept = default;
     HyperBuffer& operator= (HyperBuffer&&) noexcept = default;
     
+    /** Assignment of an element-wise expression of buffers, which is evaluated in a single pass (@see Expressions.hpp) */
+    template<class Expression, std::enable_if_t<Expression::IsExpression, int> = 0>
+    HyperBuffer& operator=(const Expression& expression)
+    {
+        evaluateExpression(*this, expression);
+        return *this;
+    }
+    
     /**
      * Copy constructor from an object with a different storage policy. Enabled only Policy differs from current one
      * (to avoid hijacking the 'normal' copy constructor).
@@ -81,8 +100,8 @@ public:
     FOR_N1                        T& operator[] (size_type i)       { return m_storage.getDataPointer_N1()[i]; }
 
     // MARK: at(...) -- Exists only for call with N parameters, returns data
-    FOR_Nx_N const T& at(size_type dn, I... i) const { return createSubBuffer(dn).at(i...); }
-    FOR_Nx_N       T& at(size_type dn, I... i)       { return createSubBuffer(dn).at(i...); }
+    FOR_Nx_N const T& at(size_type dn, I... i) const { return getElement(is_contiguous{}, dn, i...); }
+    FOR_Nx_N       T& at(size_type dn, I... i)       { return const_cast<T&>(getElement(is_contiguous{}, dn, i...)); }
     FOR_N1   const T& at(size_type i)          const { return m_storage.getDataPointer_N1()[i]; }
     FOR_N1         T& at(size_type i)                { return m_storage.getDataPointer_N1()[i]; }
     
@@ -90,13 +109,91 @@ public:
     FOR_Nx_V decltype(auto) subView(size_type dn, I... i) const { return createSubBuffer(dn).subView(i...); }
     FOR_Nx   decltype(auto) subView(size_type dn)         const { return createSubBuffer(dn); }
     
+    // MARK: stridedView() -- pointer-free view to the data (contiguous storage policies only)
+    template<bool C = is_contiguous::value, std::enable_if_t<C, int> = 0>
+    StridedView<const T, N> stridedView() const { return { m_storage.getFlatData(), m_storage.getGeometry() }; }
+    template<bool C = is_contiguous::value, std::enable_if_t<C, int> = 0>
+    StridedView<T, N> stridedView() { return { m_storage.getFlatData(), m_storage.getGeometry() }; }
+    
+    // MARK: slice(...) -- zero-copy strided view to a range of indices along any dimension (@see StridedView::slice)
+    template<bool C = is_contiguous::value, std::enable_if_t<C, int> = 0>
+    StridedView<const T, N> slice(int dim, int start, int length, int step = 1) const { return stridedView().slice(dim, start, length, step); }
+    template<bool C = is_contiguous::value, std::enable_if_t<C, int> = 0>
+    StridedView<T, N> slice(int dim, int start, int length, int step = 1) { return stridedView().slice(dim, start, length, step); }
+    
+    // MARK: broadcast(...) -- zero-copy read-only view with a larger geometry, using zero strides (@see StridedView::broadcast)
+    template<std::size_t M, bool C = is_contiguous::value, std::enable_if_t<C, int> = 0>
+    StridedView<const T, static_cast<int>(M)> broadcast(const std::array<int, M>& extents) const { return stridedView().broadcast(extents); }
+    template<std::size_t M, bool C = is_contiguous::value, std::enable_if_t<C, int> = 0>
+    StridedView<const T, static_cast<int>(M)> broadcast(const std::array<int, M>& extents, const std::array<int, N>& dims) const
+    {
+        return stridedView().broadcast(extents, dims);
+    }
+    
+    // MARK: begin()/end() -- N>1: iterates over the sub-views of the highest-order dimension, N=1: over the elements
+    FOR_Nx SubViewIterator<const HyperBuffer> begin() const noexcept { return { this, 0 }; }
+    FOR_Nx SubViewIterator<const HyperBuffer>   end() const noexcept { return { this, size(0) }; }
+    FOR_Nx       SubViewIterator<HyperBuffer> begin()       noexcept { return { this, 0 }; }
+    FOR_Nx       SubViewIterator<HyperBuffer>   end()       noexcept { return { this, size(0) }; }
+    FOR_N1                           const T* begin() const noexcept { return data(); }
+    FOR_N1                           const T*   end() const noexcept { return data() + size(0); }
+    FOR_N1                                 T* begin()       noexcept { return data(); }
+    FOR_N1                                 T*   end()       noexcept { return data() + size(0); }
+    
+    // MARK: flat() -- all elements as one range of raw pointers (contiguous storage policies without padding)
+    template<bool C = is_contiguous::value, std::enable_if_t<C, int> = 0>
+    IteratorRange<const T*> flat() const { return getFlatRange<const T>(); }
+    template<bool C = is_contiguous::value, std::enable_if_t<C, int> = 0>
+    IteratorRange<T*> flat() { return getFlatRange<T>(); }
+    
+    // MARK: rows() / elements() -- all rows (contiguous ranges), or all elements row by row (any storage policy)
+    IteratorRange<RowIterator<const T, N, const_pointer_type>>       rows() const { return getRows<const T>(data()); }
+    IteratorRange<RowIterator<T, N, pointer_type>>                   rows()       { return getRows<T>(data()); }
+    IteratorRange<SegmentedIterator<const T, N, const_pointer_type>> elements() const { return getElements<const T>(data()); }
+    IteratorRange<SegmentedIterator<T, N, pointer_type>>             elements()       { return getElements<T>(data()); }
+    
 private:
+    /** Contiguous data: calculate the element's offset in the flat data directly */
+    template<typename... I>
+    const T& getElement(std::true_type /*contiguous*/, I... i) const
+    {
+        return m_storage.getFlatData()[m_storage.getGeometry().getDataArrayOffset(i...)];
+    }
+    
+    /** Non-contiguous data: descend through the sub-dimensions */
+    template<typename... I>
+    const T& getElement(std::false_type /*contiguous*/, size_type dn, I... i) const
+    {
+        return createSubBuffer(dn).at(i...);
+    }
+    
+    template<typename U>
+    IteratorRange<U*> getFlatRange() const
+    {
+        ASSERT(BufferOperations::detail::isFlat(*this), "Data has padding, iterate over rows() instead");
+        U* first = m_storage.getFlatData();
+        return { first, first + BufferOperations::detail::numElements(sizes()) };
+    }
+    
+    offset_type getNumRows() const noexcept { return BufferOperations::detail::numElements(sizes()) / size(N-1); }
+    
+    template<typename U, typename P>
+    IteratorRange<RowIterator<U, N, P>> getRows(P pointers) const
+    {
+        return { { pointers, sizes(), 0 }, { pointers, sizes(), getNumRows() } };
+    }
+    
+    template<typename U, typename P>
+    IteratorRange<SegmentedIterator<U, N, P>> getElements(P pointers) const
+    {
+        const auto rows = getRows<U>(pointers);
+        return { { rows.begin(), rows.size(), false }, { rows.end() - 1, rows.size(), true } };
+    }
+    
     const HyperBuffer<T, N-1, typename StoragePolicy::SubBufferPolicy> createSubBuffer(size_type index) const
     {
         ASSERT(index < this->size(0), "Index out of range");
-        auto subViewData = m_storage.getSubDimData(index);
-        std::array<int, N-1> subViewDims = StdArrayOperations::shaveOffFirstElement(sizes());
-        return HyperBuffer<T, N-1, typename StoragePolicy::SubBufferPolicy>(subViewData, subViewDims);
+        return HyperBuffer<T, N-1, typename StoragePolicy::SubBufferPolicy>(m_storage.getSubDimStorage(index));
     }
     
     HyperBuffer<T, N-1, typename StoragePolicy::SubBufferPolicy> createSubBuffer(size_type index)
@@ -120,6 +217,18 @@ using HyperBufferView = HyperBuffer<T, N, StoragePolicyView <T, N>>;
 template<typename T, int N>
 using HyperBufferViewNC = HyperBuffer<T, N, StoragePolicyViewNonContiguous <T, N>>;
 
+template<typename T, int N>
+using HyperBufferSubView = HyperBuffer<T, N, StoragePolicySubView <T, N>>;
+
+template<typename T, int N, std::size_t Alignment>
+using HyperBufferAligned = HyperBuffer<T, N, StoragePolicyOwning<T, N, Alignment>>;
+
+template<typename T, int N, std::size_t Alignment = alignof(T)>
+using HyperBufferSingleBlock = HyperBuffer<T, N, StoragePolicyOwningSingleBlock<T, N, Alignment>>;
+
+template<typename T, int... Extents>
+using StaticHyperBuffer = HyperBuffer<T, sizeof...(Extents), StoragePolicyStatic<T, Extents...>>;
+
 
 
 
@@ -0,0 +1,139 @@
+//
+//  ╦ ╦┬ ┬┌─┐┌─┐┬─┐  ╔╗ ┬ ┬┌─┐┌─┐┌─┐┬─┐
+//  ╠═╣└┬┘├─┘├┤ ├┬┘  ╠╩╗│ │├┤ ├┤ ├┤ ├┬┘
+//  ╩ ╩ ┴ ┴  └─┘┴└─  ╚═╝└─┘└  └  └─┘┴└─
+//
+//  © 2023 Lorenz Bucher - all rights reserved
+//  https://github.com/Sidelobe/HyperBuffer
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <utility>
+
+#include "HyperBuffer.hpp"
+
+namespace slb
+{
+
+/**
+ *  Circular buffer over the innermost dimension of N-dimensional data, e.g. a multichannel delay line or lookback
+ *  history of [channel][sample]: blocks of data are written at the write head, which wraps around after `capacity`
+ *  elements. The history is read through windows that end a given delay before the write head.
+ *
+ *  Every row is mirrored: it is allocated with twice the capacity, and every element is written to both halves.
+ *  Any window of up to `capacity` elements is therefore contiguous in memory, even if it crosses the wrap point - the
+ *  rows of a window are plain `T*` that SIMD kernels can process without any index wrapping or splitting:
+ *
+ *      HyperBufferCircular<float, 2> delayLine(numChannels, maxDelay + blockSize);
+ *      delayLine.write(input);                            // [channel][sample] block
+ *      auto tap = delayLine.getWindow(blockSize, delay);  // the block written `delay` samples ago
+ *      SimdKernels::multiplyAccumulate(output[ch], &tap[ch][0], gain, blockSize); // one contiguous row per channel
+ *
+ *  - Guarantees: Dynamic memory allocation only during construction; writing & reading windows never allocates.
+ *  - Memory: 2 x capacity elements per row; writing costs two stores per element.
+ *  - Initial state: the history is zero (silence) until `capacity` elements have been written.
+ *
+ *  - Template parameters: T=data type (e.g. float),  N=dimension (e.g. 2), StoragePolicy of the (contiguous) rows
+ */
+template<typename T, int N, class StoragePolicy = StoragePolicyOwning<T, N>>
+class HyperBufferCircular
+{
+    static_assert(StoragePolicy::IsContiguous, "Requires a storage policy with contiguous data");
+
+public:
+    /** Constructor that takes the extents of the dimensions; the innermost one is the capacity of the rows */
+    template<typename... I>
+    explicit HyperBufferCircular(I... i) :
+        m_capacity(getCapacity(i...)),
+        m_buffer(createBuffer(std::array<int, N>{{ static_cast<int>(i)... }}, std::make_index_sequence<N-1>{}))
+    {
+        static_assert(sizeof...(I) == N, "Incorrect number of arguments");
+        BufferOperations::fill(m_buffer, T{});
+    }
+
+    /** @returns the number of elements each row retains */
+    int capacity() const noexcept { return m_capacity; }
+
+    /** @returns the extent of the dimension; the innermost one is the capacity */
+    int size(int i) const { return (i == N-1) ? m_capacity : m_buffer.size(i); }
+
+    /** @returns the index (in [0, capacity)) at which the next element of every row will be written */
+    int getWritePosition() const noexcept { return m_writePosition; }
+
+    /**
+     * Writes a block of data at the write head and advances it by the block's innermost extent (at most the capacity).
+     * The other extents of the block have to match the buffer's.
+     */
+    template<class BlockStoragePolicy>
+    void write(const HyperBuffer<T, N, BlockStoragePolicy>& block)
+    {
+        const int numElements = block.size(N-1);
+        ASSERT(numElements <= m_capacity, "Block exceeds the capacity");
+        for (int i = 0; i < N-1; ++i) {
+            ASSERT(block.size(i) == m_buffer.size(i), "Extents of the block do not match");
+        }
+        auto rowOp = [this](offset_type n, T* row, const T* source) { writeRow(row, source, n); };
+        BufferOperations::detail::forEachRow(std::integral_constant<int, N>{}, block.sizes().data(), rowOp, m_buffer.data(), block.data());
+        m_writePosition = (m_writePosition + numElements) % m_capacity;
+    }
+
+    /**
+     * @returns a read-only, zero-copy view to the `length` elements of every row that were written `delay` elements
+     * before the most recent one, i.e. `getWindow(n)` holds the n most recent elements (oldest first). Every row of the
+     * window is contiguous in memory. Requires length + delay <= capacity.
+     * @note the window shows the data in place: it is only valid until the next write() that overwrites it.
+     */
+    StridedView<const T, N> getWindow(int length, int delay = 0) const
+    {
+        ASSERT(length >= 0 && delay >= 0 && length + delay <= m_capacity, "Window exceeds the capacity");
+        int start = m_writePosition - delay - length;
+        if (start < 0) {
+            start += m_capacity;
+        }
+        return m_buffer.slice(N-1, start, length);
+    }
+
+    /** Resets the history to zero and the write head to the start */
+    void clear()
+    {
+        BufferOperations::fill(m_buffer, T{});
+        m_writePosition = 0;
+    }
+
+private:
+    template<typename... I>
+    static int getCapacity(I... i)
+    {
+        const std::array<int, sizeof...(I)> extents {{ static_cast<int>(i)... }};
+        ASSERT(extents.back() > 0, "Invalid Dimension extents");
+        return extents.back();
+    }
+
+    /** @returns the mirrored storage: the same extents, but twice the capacity */
+    template<std::size_t... I>
+    static HyperBuffer<T, N, StoragePolicy> createBuffer(const std::array<int, N>& extents, std::index_sequence<I...>)
+    {
+        return HyperBuffer<T, N, StoragePolicy>(extents[I]..., 2 * extents[N-1]);
+    }
+
+    /** Writes n elements at the write head: to both halves of the row, wrapping around at the capacity */
+    void writeRow(T* row, const T* source, offset_type n) const noexcept
+    {
+        const offset_type first = std::min<offset_type>(n, m_capacity - m_writePosition);
+        SimdKernels::copy(row + m_writePosition, source, first);
+        SimdKernels::copy(row + m_writePosition + m_capacity, source, first);
+        SimdKernels::copy(row, source + first, n - first);
+        SimdKernels::copy(row + m_capacity, source + first, n - first);
+    }
+
+private:
+    int m_capacity;
+    int m_writePosition = 0;
+
+    /** The rows, each with 2 x capacity elements */
+    HyperBuffer<T, N, StoragePolicy> m_buffer;
+};
+
+} // namespace slb
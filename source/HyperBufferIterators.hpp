@@ -0,0 +1,205 @@
+//
+//  ╦ ╦┬ ┬┌─┐┌─┐┬─┐  ╔╗ ┬ ┬┌─┐┌─┐┌─┐┬─┐
+//  ╠═╣└┬┘├─┘├┤ ├┬┘  ╠╩╗│ │├┤ ├┤ ├┤ ├┬┘
+//  ╩ ╩ ┴ ┴  └─┘┴└─  ╚═╝└─┘└  └  └─┘┴└─
+//
+//  © 2023 Lorenz Bucher - all rights reserved
+//  https://github.com/Sidelobe/HyperBuffer
+
+#pragma once
+
+#include <array>
+#include <iterator>
+#include <type_traits>
+
+#include "TemplateUtils.hpp"
+
+namespace slb
+{
+
+/**
+ * A pair of iterators that can be used in range-based for loops and with STL algorithms, e.g. the elements of a row:
+ *      std::transform(row.begin(), row.end(), row.begin(), ...);
+ */
+template<typename Iterator>
+class IteratorRange
+{
+public:
+    IteratorRange(Iterator begin, Iterator end) : m_begin(begin), m_end(end) {}
+
+    Iterator begin() const { return m_begin; }
+    Iterator end() const { return m_end; }
+
+    /** Random-access iterators only */
+    offset_type size() const { return static_cast<offset_type>(m_end - m_begin); }
+    decltype(auto) operator[] (offset_type i) const { return m_begin[i]; }
+
+private:
+    Iterator m_begin;
+    Iterator m_end;
+};
+
+namespace detail
+{
+/**
+ * Base class for random-access iterators that are defined by an index (e.g. of a sub-view or a row), and which yield
+ * a value (e.g. a view), not a reference. The Derived class provides `operator*`.
+ */
+template<class Derived>
+class IndexIterator
+{
+public:
+    using difference_type   = offset_type;
+    using iterator_category = std::random_access_iterator_tag;
+    using pointer           = void;
+
+    offset_type getIndex() const noexcept { return m_index; }
+
+    Derived& operator++() noexcept { ++m_index; return derived(); }
+    Derived& operator--() noexcept { --m_index; return derived(); }
+    Derived operator++(int) noexcept { Derived previous = derived(); ++m_index; return previous; }
+    Derived operator--(int) noexcept { Derived previous = derived(); --m_index; return previous; }
+    Derived& operator+=(offset_type n) noexcept { m_index += n; return derived(); }
+    Derived& operator-=(offset_type n) noexcept { m_index -= n; return derived(); }
+    Derived operator+(offset_type n) const noexcept { Derived result = derived(); return result += n; }
+    Derived operator-(offset_type n) const noexcept { Derived result = derived(); return result -= n; }
+    friend Derived operator+(offset_type n, const Derived& it) noexcept { return it + n; }
+    offset_type operator-(const IndexIterator& other) const noexcept { return m_index - other.m_index; }
+    decltype(auto) operator[](offset_type n) const { return *(derived() + n); }
+
+    bool operator==(const IndexIterator& other) const noexcept { return m_index == other.m_index; }
+    bool operator!=(const IndexIterator& other) const noexcept { return m_index != other.m_index; }
+    bool operator< (const IndexIterator& other) const noexcept { return m_index <  other.m_index; }
+    bool operator> (const IndexIterator& other) const noexcept { return m_index >  other.m_index; }
+    bool operator<=(const IndexIterator& other) const noexcept { return m_index <= other.m_index; }
+    bool operator>=(const IndexIterator& other) const noexcept { return m_index >= other.m_index; }
+
+protected:
+    explicit IndexIterator(offset_type index) noexcept : m_index(index) {}
+
+private:
+    Derived& derived() noexcept { return static_cast<Derived&>(*this); }
+    const Derived& derived() const noexcept { return static_cast<const Derived&>(*this); }
+
+    offset_type m_index;
+};
+
+/** Descends through the pointer structure to the row with the given (flat) index: D = remaining dimensions */
+template<typename P>
+P getRowPointer(std::integral_constant<int, 1>, P row, const int* /*extents*/, offset_type /*rowIndex*/) noexcept
+{
+    return row;
+}
+
+template<int D, typename P>
+auto getRowPointer(std::integral_constant<int, D>, P pointers, const int* extents, offset_type rowIndex) noexcept
+{
+    offset_type rowsPerIndex = 1;
+    for (int i = 1; i < D-1; ++i) {
+        rowsPerIndex *= extents[i];
+    }
+    return getRowPointer(std::integral_constant<int, D-1>{}, pointers[rowIndex / rowsPerIndex], extents + 1, rowIndex % rowsPerIndex);
+}
+} // namespace detail
+
+/**
+ * Random-access iterator over the sub-views of the outermost dimension of a HyperBuffer (any storage policy), e.g.
+ * over the channels of a [channel][sample] buffer. Dereferencing creates the sub-view, without allocation.
+ * @note the iterator yields views by value (like a proxy iterator), it cannot be dereferenced with `->`.
+ */
+template<class Buffer>
+class SubViewIterator : public detail::IndexIterator<SubViewIterator<Buffer>>
+{
+    using SubBuffer = std::decay_t<decltype(std::declval<Buffer&>().subView(0))>;
+
+public:
+    using value_type = SubBuffer;
+    using reference  = std::conditional_t<std::is_const<Buffer>::value, const SubBuffer, SubBuffer>;
+
+    SubViewIterator(Buffer* buffer, offset_type index) noexcept :
+        detail::IndexIterator<SubViewIterator>(index), m_buffer(buffer) {}
+
+    reference operator*() const { return m_buffer->subView(static_cast<int>(this->getIndex())); }
+
+private:
+    Buffer* m_buffer;
+};
+
+/**
+ * Random-access iterator over all rows (i.e. the lowest-order dimension) of a HyperBuffer of any storage policy, in
+ * the order of the indices. Every row is a contiguous range of elements: `IteratorRange<T*>`.
+ * This is the segmented view of the data: the outer loop over rows (segments) has a cost of one pointer look-up per
+ * dimension, the inner loop over the elements of a row runs on raw pointers.
+ */
+template<typename T, int N, typename PointerType>
+class RowIterator : public detail::IndexIterator<RowIterator<T, N, PointerType>>
+{
+public:
+    using value_type = IteratorRange<T*>;
+    using reference  = IteratorRange<T*>;
+
+    RowIterator(PointerType pointers, const std::array<int, N>& extents, offset_type rowIndex) noexcept :
+        detail::IndexIterator<RowIterator>(rowIndex), m_pointers(pointers), m_extents(extents) {}
+
+    reference operator*() const noexcept
+    {
+        T* row = detail::getRowPointer(std::integral_constant<int, N>{}, m_pointers, m_extents.data(), this->getIndex());
+        return { row, row + m_extents[N-1] };
+    }
+
+private:
+    PointerType m_pointers;
+    std::array<int, N> m_extents;
+};
+
+/**
+ * Forward iterator over all elements of a HyperBuffer of any storage policy, in the order of the indices. It walks
+ * the elements of a row with a raw pointer and jumps to the next row at its end (segmented iteration), which makes
+ * STL algorithms (std::copy, std::accumulate, ...) work on non-contiguous data.
+ * @note For contiguous storage policies, flat() yields raw pointers, which is faster.
+ */
+template<typename T, int N, typename PointerType>
+class SegmentedIterator
+{
+    using Rows = RowIterator<T, N, PointerType>;
+
+public:
+    using difference_type   = offset_type;
+    using value_type        = std::remove_const_t<T>;
+    using pointer           = T*;
+    using reference         = T&;
+    using iterator_category = std::forward_iterator_tag;
+
+    /** @param atEnd start at the end of the given row (the last one for end()), otherwise at its beginning */
+    SegmentedIterator(Rows row, offset_type numRows, bool atEnd) noexcept : m_row(row), m_numRows(numRows)
+    {
+        const auto range = *m_row;
+        m_position = atEnd ? range.end() : range.begin();
+        m_rowEnd = range.end();
+    }
+
+    reference operator*() const noexcept { return *m_position; }
+    pointer operator->() const noexcept { return m_position; }
+
+    SegmentedIterator& operator++() noexcept
+    {
+        if (++m_position == m_rowEnd && m_row.getIndex() + 1 < m_numRows) {
+            const auto range = *(++m_row);
+            m_position = range.begin();
+            m_rowEnd = range.end();
+        }
+        return *this;
+    }
+    SegmentedIterator operator++(int) noexcept { SegmentedIterator previous = *this; ++(*this); return previous; }
+
+    bool operator==(const SegmentedIterator& other) const noexcept { return m_row == other.m_row && m_position == other.m_position; }
+    bool operator!=(const SegmentedIterator& other) const noexcept { return !(*this == other); }
+
+private:
+    Rows m_row;
+    offset_type m_numRows;
+    T* m_position;
+    T* m_rowEnd;
+};
+
+} // namespace slb
@@ -0,0 +1,156 @@
+//
+//  ╦ ╦┬ ┬┌─┐┌─┐┬─┐  ╔╗ ┬ ┬┌─┐┌─┐┌─┐┬─┐
+//  ╠═╣└┬┘├─┘├┤ ├┬┘  ╠╩╗│ │├┤ ├┤ ├┤ ├┬┘
+//  ╩ ╩ ┴ ┴  └─┘┴└─  ╚═╝└─┘└  └  └─┘┴└─
+//
+//  © 2023 Lorenz Bucher - all rights reserved
+//  https://github.com/Sidelobe/HyperBuffer
+
+#pragma once
+
+#include <array>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "HyperBuffer.hpp"
+#include "MappedFile.hpp"
+
+namespace slb
+{
+
+/**
+ *  Memory model for HyperBuffers whose data resides in a file: the data is memory-mapped (the file is the data
+ *  array), the pointers are owned by this class. The file is expected to contain the flat data in the HyperBuffer
+ *  memory format (unpadded, unless a padded geometry is given), optionally preceded by a header (skipped with
+ *  `Options::offset`).
+ *
+ *  Construction is instantaneous regardless of the size of the data: the OS pages it in lazily, upon first access.
+ *
+ *  Modes (@see MappedFile::Mode):
+ *  - ReadOnly: requires a const data type, e.g. HyperBufferMapped<const float, 2>
+ *  - ReadWrite: the file is created/extended as needed and modifications are written back to it
+ *  - CopyOnWrite: modifications are private to this buffer, the file remains untouched
+ *
+ *  @note The mapping is not shared between copies: this class can be moved, but not copied.
+ *
+ *  - Template parameters: T=data type (e.g. float),  N=dimension (e.g. 3)
+ */
+template<typename T, int N>
+class StoragePolicyMapped
+{
+    using size_type                 = int;
+    using pointer_type              = typename add_pointers_to_type<T, N>::type;
+    using const_pointer_type        = typename add_const_pointers_to_type<T, N>::type;
+
+    static_assert(std::is_trivially_copyable<T>::value, "Mapped data type must be trivially copyable");
+
+public:
+    using SubBufferPolicy = StoragePolicySubView<T, N-1>;
+    static constexpr bool IsContiguous = true;
+
+    /** Constructor that takes the file, the mode and the extents of the dimensions as a variable argument list */
+    template<typename... I>
+    StoragePolicyMapped(const std::string& path, MappedFile::Mode mode, I... i) :
+        StoragePolicyMapped(path, MappedFile::Options{mode}, std::array<int, N>{{ static_cast<int>(i)... }})
+    {
+        static_assert(sizeof...(I) == N, "Incorrect number of arguments");
+    }
+
+    /** Constructor that takes the file, the mapping options and the extents of the dimensions as a variable argument list */
+    template<typename... I>
+    StoragePolicyMapped(const std::string& path, const MappedFile::Options& options, I... i) :
+        StoragePolicyMapped(path, options, std::array<int, N>{{ static_cast<int>(i)... }})
+    {
+        static_assert(sizeof...(I) == N, "Incorrect number of arguments");
+    }
+
+    /** Constructor that takes the file, the mapping options and the extents of the dimensions as a std::array */
+    StoragePolicyMapped(const std::string& path, const MappedFile::Options& options, const std::array<int, N>& dimensionExtents) :
+        StoragePolicyMapped(path, options, BufferGeometry<N>(dimensionExtents))
+    {
+    }
+
+    /** Constructor that takes the file, the mapping options and the (possibly padded) geometry of the data in the file */
+    StoragePolicyMapped(const std::string& path, const MappedFile::Options& options, const BufferGeometry<N>& bufferGeometry) :
+        m_bufferGeometry(checkedGeometry(bufferGeometry, options)),
+        m_file(path, options.mode, options.offset,
+               static_cast<std::size_t>(m_bufferGeometry.getRequiredDataArraySize()) * sizeof(T)),
+        m_pointers(m_bufferGeometry.getRequiredPointerArraySize())
+    {
+        m_file.advise(options.hint);
+        m_bufferGeometry.hookupPointerArrayToData(getFlatData(), m_pointers.data());
+    }
+
+    ~StoragePolicyMapped() = default;
+
+    StoragePolicyMapped(const StoragePolicyMapped&) = delete;
+    StoragePolicyMapped& operator=(const StoragePolicyMapped&) = delete;
+
+    // MARK: moving leaves the mapping in place, the pointers remain valid
+    StoragePolicyMapped(StoragePolicyMapped&&) noexcept = default;
+    StoragePolicyMapped& operator=(StoragePolicyMapped&&) noexcept = default;
+
+    /** @return a modifiable pointer to a subdimension of the data */
+    T* getSubDimData(size_type index) const
+    {
+        const offset_type offset = m_bufferGeometry.getDataArrayOffsetForHighestOrderSubDim(index);
+        return &getFlatData()[offset];
+    }
+
+    /** @return the storage for a view to a subdimension of the data, which borrows a slice of the pointer array */
+    SubBufferPolicy getSubDimStorage(size_type index) const
+    {
+        return SubBufferPolicy(getPointers()[index], getSubDimData(index), m_bufferGeometry.getSubDimGeometry());
+    }
+
+    int size(int i) const { ASSERT(i < N); return m_bufferGeometry.getDimensionExtents()[i]; }
+    const std::array<int, N>& sizes() const noexcept { return m_bufferGeometry.getDimensionExtents(); }
+    const BufferGeometry<N>& getGeometry() const noexcept { return m_bufferGeometry; }
+
+    /** @return a modifiable pointer to the start of the flat (1D) data, i.e. the mapped memory */
+    T* getFlatData() const noexcept { return static_cast<T*>(m_file.data()); }
+
+    const_pointer_type getDataPointer_Nx() const noexcept { return getPointers(); }
+          pointer_type getDataPointer_Nx()       noexcept { return getPointers(); }
+              const T* getDataPointer_N1() const noexcept { return *m_pointers.data(); }
+                    T* getDataPointer_N1()       noexcept { return *m_pointers.data(); }
+
+private:
+    /** @return the pointer array as N-dimensional pointer (cast via void*, which is also valid for a const T) */
+    pointer_type getPointers() const noexcept
+    {
+        return static_cast<pointer_type>(static_cast<void*>(const_cast<T**>(m_pointers.data())));
+    }
+    
+    /** Validates the arguments before anything is mapped */
+    static const BufferGeometry<N>& checkedGeometry(const BufferGeometry<N>& bufferGeometry, const MappedFile::Options& options)
+    {
+        for (int extent : bufferGeometry.getDimensionExtents()) {
+            ASSERT(extent > 0, "Invalid Dimension extents");
+        }
+        ASSERT(options.offset % alignof(T) == 0, "Offset must be a multiple of the alignment of the data type");
+        ASSERT(std::is_const<T>::value || options.mode != MappedFile::Mode::ReadOnly,
+               "Read-only mappings require a const data type");
+        return bufferGeometry;
+    }
+
+private:
+    /** Handles the geometry (organization) of the data memory, enabling multi-dimensional access to it */
+    BufferGeometry<N> m_bufferGeometry;
+
+    /** The mapped data memory */
+    MappedFile m_file;
+
+    using PointerAllocator = AlignedAllocator<T*>;
+
+    /** All but the innermost dimensions consist of pointers only, which are stored in a 1D structure as well */
+    std::vector<T*, PointerAllocator> m_pointers;
+};
+
+// MARK: Alias (for convenience)
+
+template<typename T, int N>
+using HyperBufferMapped = HyperBuffer<T, N, StoragePolicyMapped<T, N>>;
+
+} // namespace slb
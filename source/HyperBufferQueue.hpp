@@ -0,0 +1,167 @@
+//
+//  ╦ ╦┬ ┬┌─┐┌─┐┬─┐  ╔╗ ┬ ┬┌─┐┌─┐┌─┐┬─┐
+//  ╠═╣└┬┘├─┘├┤ ├┬┘  ╠╩╗│ │├┤ ├┤ ├┤ ├┬┘
+//  ╩ ╩ ┴ ┴  └─┘┴└─  ╚═╝└─┘└  └  └─┘┴└─
+//
+//  © 2023 Lorenz Bucher - all rights reserved
+//  https://github.com/Sidelobe/HyperBuffer
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+#include "HyperBuffer.hpp"
+
+namespace slb
+{
+
+/**
+ *  Lock-free single-producer / single-consumer queue of preallocated HyperBuffers (slots) of identical geometry, to
+ *  hand off blocks of data between two threads (e.g. from a realtime thread to a worker thread and vice versa).
+ *
+ *  The slots are allocated during construction. Afterwards, the data is written and read in place:
+ *
+ *      // producer thread                              // consumer thread
+ *      if (auto* slot = queue.acquireWrite()) {        if (auto* slot = queue.acquireRead()) {
+ *          fillWithData(*slot);                            process(*slot);
+ *          queue.publish();                                queue.release();
+ *      }                                               }
+ *
+ *  - Guarantees: no allocation, no locks and no system calls after construction; all operations are wait-free.
+ *  - Threading: acquireWrite()/publish()/tryPush() must be called from one (producer) thread only,
+ *    acquireRead()/release()/tryPop() from one (consumer) thread only.
+ *  - Memory: the write and read indices reside on separate cache lines (@see CacheLineSize), each together with a
+ *    cached copy of the other index, so the threads only touch each other's cache line if the cached copy is outdated.
+ *
+ *  - Template parameters: T=data type (e.g. float),  N=dimension (e.g. 3), StoragePolicy of the slots
+ */
+template<typename T, int N, class StoragePolicy = StoragePolicyOwning<T, N>>
+class HyperBufferQueue
+{
+public:
+    using Buffer = HyperBuffer<T, N, StoragePolicy>;
+
+    /**
+     * Constructor that takes the number of slots, followed by the arguments of the slots' constructor (e.g. the
+     * extents of the dimensions, optionally preceded by a MemoryResource)
+     */
+    template<typename... I>
+    explicit HyperBufferQueue(int capacity, I... i)
+    {
+        ASSERT(capacity > 0, "Capacity must be positive");
+        m_slots.reserve(static_cast<std::size_t>(capacity));
+        for (int slot = 0; slot < capacity; ++slot) {
+            m_slots.emplace_back(i...);
+        }
+    }
+
+    // MARK: the slots are shared between two threads: neither copyable nor movable
+    HyperBufferQueue(const HyperBufferQueue&) = delete;
+    HyperBufferQueue& operator=(const HyperBufferQueue&) = delete;
+
+    int capacity() const noexcept { return static_cast<int>(m_slots.size()); }
+
+    /** @returns the number of published, not yet released slots (only a snapshot if called concurrently) */
+    int getNumReadable() const noexcept
+    {
+        const std::size_t readIndex = m_consumer.index.load(std::memory_order_acquire);
+        return static_cast<int>(m_producer.index.load(std::memory_order_acquire) - readIndex);
+    }
+
+    bool isEmpty() const noexcept { return getNumReadable() == 0; }
+
+    // MARK: - Producer
+
+    /**
+     * @returns the next free slot, to be filled and then handed to the consumer with publish(), or nullptr if all slots
+     * are in use (queue is full). Calling it repeatedly without publish() returns the same slot.
+     */
+    Buffer* acquireWrite() noexcept
+    {
+        const std::size_t writeIndex = m_producer.index.load(std::memory_order_relaxed);
+        if (writeIndex - m_producer.cachedOtherIndex == m_slots.size()) {
+            m_producer.cachedOtherIndex = m_consumer.index.load(std::memory_order_acquire);
+            if (writeIndex - m_producer.cachedOtherIndex == m_slots.size()) {
+                return nullptr;
+            }
+        }
+        return &m_slots[writeIndex % m_slots.size()];
+    }
+
+    /** Hands the slot returned by acquireWrite() to the consumer. @note requires a preceding successful acquireWrite() */
+    void publish() noexcept
+    {
+        m_producer.index.store(m_producer.index.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    /** Copies the source into the next free slot and publishes it. @returns false if the queue is full */
+    template<class SrcStoragePolicy>
+    bool tryPush(const HyperBuffer<T, N, SrcStoragePolicy>& source)
+    {
+        Buffer* slot = acquireWrite();
+        if (slot == nullptr) {
+            return false;
+        }
+        BufferOperations::copy(*slot, source);
+        publish();
+        return true;
+    }
+
+    // MARK: - Consumer
+
+    /**
+     * @returns the oldest published slot, to be handed back to the producer with release() when done, or nullptr if no
+     * slot has been published (queue is empty). Calling it repeatedly without release() returns the same slot.
+     */
+    Buffer* acquireRead() noexcept
+    {
+        const std::size_t readIndex = m_consumer.index.load(std::memory_order_relaxed);
+        if (readIndex == m_consumer.cachedOtherIndex) {
+            m_consumer.cachedOtherIndex = m_producer.index.load(std::memory_order_acquire);
+            if (readIndex == m_consumer.cachedOtherIndex) {
+                return nullptr;
+            }
+        }
+        return &m_slots[readIndex % m_slots.size()];
+    }
+
+    /** Hands the slot returned by acquireRead() back to the producer. @note requires a preceding successful acquireRead() */
+    void release() noexcept
+    {
+        m_consumer.index.store(m_consumer.index.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    /** Copies the oldest published slot into the destination and releases it. @returns false if the queue is empty */
+    template<class DstStoragePolicy>
+    bool tryPop(HyperBuffer<T, N, DstStoragePolicy>& destination)
+    {
+        Buffer* slot = acquireRead();
+        if (slot == nullptr) {
+            return false;
+        }
+        BufferOperations::copy(destination, *slot);
+        release();
+        return true;
+    }
+
+private:
+    /**
+     * Index owned (written) by one thread, padded to a cache line. The indices increase monotonically, the slot is
+     * `index % capacity`. The cached copy of the other thread's index is only refreshed when the queue seems full/empty.
+     */
+    struct alignas(CacheLineSize) Index
+    {
+        std::atomic<std::size_t> index { 0 };
+        std::size_t cachedOtherIndex = 0;
+    };
+
+    Index m_producer; // write index
+    Index m_consumer; // read index
+
+    /** The slots, allocated during construction only */
+    alignas(CacheLineSize) std::vector<Buffer> m_slots;
+};
+
+} // namespace slb
@@ -9,15 +9,18 @@
 #pragma once
 
 #include <array>
+#include <memory>
 #include <vector>
 
 #include "TemplateUtils.hpp"
+#include "AlignedAllocator.hpp"
 #include "BufferGeometry.hpp"
 
 namespace slb
 {
 
 template<typename T, int N> class StoragePolicyView; // forward declaration
+template<typename T, int N> class StoragePolicySubView; // forward declaration
 
 /**
  *  Native memory model for HyperBuffer: full ownership of data and pointer memory.
@@ -26,38 +29,93 @@ template<typename T, int N> class StoragePolicyView; // forward declaration
  *  Memory for the pointers and the data is allocated separately, but each in a 1-dimensional block of memory, which
  *  results in only two allocations for the entire multi-dimensional data, regardless of the dimensions.
  *
- *  - Template parameters: T=data type (e.g. float),  N=dimension (e.g. 3)
+ *  The data block is aligned to the given number of bytes. If this is larger than the natural alignment of T, every
+ *  row of the lowest-order dimension is padded such that it starts on an aligned address as well.
+ *
+ *  All memory is drawn from a MemoryResource, which can be passed to the constructor ahead of the extents (otherwise,
+ *  the default resource is used). Copies draw from the same resource as the original.
+ *
+ *  - Template parameters: T=data type (e.g. float),  N=dimension (e.g. 3), Alignment=alignment in bytes (e.g. 64)
  */
-template<typename T, int N>
+template<typename T, int N, std::size_t Alignment = alignof(T)>
 class StoragePolicyOwning
 {
     using size_type                 = int;
     using pointer_type              = typename add_pointers_to_type<T, N>::type;
     using const_pointer_type        = typename add_const_pointers_to_type<T, N>::type;
+    
+    static_assert(AlignedMemory::isPowerOfTwo(Alignment) && Alignment >= alignof(T), "Invalid alignment");
+    
+    /** Granularity (in elements) of the rows of the lowest-order dimension required to keep them aligned */
+    static constexpr int RowAlignment = AlignedMemory::getAlignmentInElements<T>(Alignment);
 
 public:
-    using SubBufferPolicy = StoragePolicyView<T, N-1>; // SubBuffers of an 'owning' are always a 'view' !
+    using SubBufferPolicy = StoragePolicySubView<T, N-1>; // SubBuffers of an 'owning' are always a 'view' !
+    static constexpr bool IsContiguous = true;
     
     /** Constructor that takes the extents of the dimensions as a variable argument list */
     template<typename... I>
-    explicit StoragePolicyOwning(I... i) :
-        m_bufferGeometry(i...),
-        m_data(m_bufferGeometry.getRequiredDataArraySize()),
-        m_pointers(m_bufferGeometry.getRequiredPointerArraySize())
+    explicit StoragePolicyOwning(I... i) : StoragePolicyOwning(MemoryResources::getDefaultResource(), i...) {}
+    
+    /** Constructor that takes the resource to draw all memory from, followed by the extents of the dimensions */
+    template<class Resource, typename... I, std::enable_if_t<std::is_base_of<MemoryResource, Resource>::value, int> = 0>
+    StoragePolicyOwning(Resource* memoryResource, I... i) :
+        m_bufferGeometry(BufferGeometry<N>(i...).withAlignedRows(RowAlignment)),
+        m_data(m_bufferGeometry.getRequiredDataArraySize(), DataAllocator(memoryResource)),
+        m_pointers(m_bufferGeometry.getRequiredPointerArraySize(), PointerAllocator(memoryResource))
     {
         ASSERT(CompiletimeMath::areAllPositive(i...), "Invalid Dimension extents");
         m_bufferGeometry.hookupPointerArrayToData(m_data.data(), m_pointers.data());
     }
     
+    ~StoragePolicyOwning() = default;
+    
+    // MARK: copying requires the pointers to be hooked up to the copied data (moving leaves the data in place)
+    StoragePolicyOwning(const StoragePolicyOwning& other) :
+        m_bufferGeometry(other.m_bufferGeometry),
+        m_data(other.m_data),
+        m_pointers(other.m_pointers.size(), nullptr, other.m_pointers.get_allocator())
+    {
+        m_bufferGeometry.hookupPointerArrayToData(m_data.data(), m_pointers.data());
+    }
+    
+    StoragePolicyOwning& operator=(const StoragePolicyOwning& other)
+    {
+        if (this != &other) {
+            m_bufferGeometry = other.m_bufferGeometry;
+            m_data = other.m_data;
+            m_pointers.resize(other.m_pointers.size());
+            m_bufferGeometry.hookupPointerArrayToData(m_data.data(), m_pointers.data());
+        }
+        return *this;
+    }
+    
+    StoragePolicyOwning(StoragePolicyOwning&&) noexcept = default;
+    StoragePolicyOwning& operator=(StoragePolicyOwning&&) noexcept = default;
+    
     /** @return a modifiable pointer to a subdimension of the data */
     T* getSubDimData(size_type index) const
     {
-        const int offset = m_bufferGeometry.getDataArrayOffsetForHighestOrderSubDim(index);
+        const offset_type offset = m_bufferGeometry.getDataArrayOffsetForHighestOrderSubDim(index);
         return getRawData(offset);
     }
+    
+    /** @return the storage for a (non-owning) view to a subdimension, which borrows a slice of the pointer array */
+    SubBufferPolicy getSubDimStorage(size_type index) const
+    {
+        auto pointers = reinterpret_cast<pointer_type>(const_cast<T**>(m_pointers.data()));
+        return SubBufferPolicy(pointers[index], getSubDimData(index), m_bufferGeometry.getSubDimGeometry());
+    }
 
     int size(int i) const { ASSERT(i < N); return m_bufferGeometry.getDimensionExtents()[i]; }
     const std::array<int, N>& sizes() const noexcept { return m_bufferGeometry.getDimensionExtents(); }
+    const BufferGeometry<N>& getGeometry() const noexcept { return m_bufferGeometry; }
+    
+    /** @return a modifiable pointer to the start of the flat (1D) data */
+    T* getFlatData() const noexcept { return getRawData(); }
+    
+    /** @return the resource all memory is drawn from */
+    MemoryResource* getMemoryResource() const noexcept { return m_data.get_allocator().getResource(); }
 
     const_pointer_type getDataPointer_Nx() const noexcept { return reinterpret_cast<const_pointer_type>(m_pointers.data()); }
           pointer_type getDataPointer_Nx()       noexcept { return reinterpret_cast<pointer_type>(m_pointers.data()); }
@@ -70,32 +128,227 @@ private:
      * @note The const_cast is unfortunately necessary to resolve an ambiguity in the scenario of creating a subBuffer
      * view from an owning buffer (this rabbithole is deep...)
      */
-    T* getRawData(int offset = 0) const
+    T* getRawData(offset_type offset = 0) const
     {
-        return const_cast<T*>(&m_data[offset]);
+        return const_cast<T*>(m_data.data() + offset);
     }
 
 private:
-    friend class StoragePolicyView<T, N>;
-    
     /** Handles the geometry (organization) of the data memory, enabling multi-dimensional access to it */
     BufferGeometry<N> m_bufferGeometry;
     
+    using DataAllocator = AlignedAllocator<T, Alignment>;
+    using PointerAllocator = AlignedAllocator<T*>;
+    
     /** All the data (innermost dimension) is stored in a 1D structure and access with offsets to simulate multi-dimensionality */
-    std::vector<T> m_data;
+    std::vector<T, DataAllocator> m_data;
     
     /** All but the innermost dimensions consist of pointers only, which are stored in a 1D structure as well */
-    std::vector<T*> m_pointers;
+    std::vector<T*, PointerAllocator> m_pointers;
 };
 
 
+// ====================================================================================================================
+/**
+ *  Alternative to the native memory model (StoragePolicyOwning) with full ownership of data and pointer memory, where
+ *  pointers and data share a single block of memory: the pointer array is immediately followed by the (aligned) data.
+ *  This results in only one allocation for the entire multi-dimensional data and keeps the pointers close to the data.
+ *
+ *  The data block is aligned to the given number of bytes. If this is larger than the natural alignment of T, every
+ *  row of the lowest-order dimension is padded such that it starts on an aligned address as well.
+ *
+ *  The block is drawn from a MemoryResource, which can be passed to the constructor ahead of the extents (otherwise,
+ *  the default resource is used). Copies draw from the same resource as the original.
+ *
+ *  - Template parameters: T=data type (e.g. float),  N=dimension (e.g. 3), Alignment=alignment in bytes (e.g. 64)
+ */
+template<typename T, int N, std::size_t Alignment = alignof(T)>
+class StoragePolicyOwningSingleBlock
+{
+    using size_type                 = int;
+    using pointer_type              = typename add_pointers_to_type<T, N>::type;
+    using const_pointer_type        = typename add_const_pointers_to_type<T, N>::type;
+    
+    static_assert(AlignedMemory::isPowerOfTwo(Alignment) && Alignment >= alignof(T), "Invalid alignment");
+    
+    /** Granularity (in elements) of the rows of the lowest-order dimension required to keep them aligned */
+    static constexpr int RowAlignment = AlignedMemory::getAlignmentInElements<T>(Alignment);
+    
+    /** The block has to satisfy the alignment of both the pointers and the data */
+    static constexpr std::size_t BlockAlignment = (Alignment > alignof(T*)) ? Alignment : alignof(T*);
+
+public:
+    using SubBufferPolicy = StoragePolicySubView<T, N-1>; // SubBuffers of an 'owning' are always a 'view' !
+    static constexpr bool IsContiguous = true;
+    
+    /** Constructor that takes the extents of the dimensions as a variable argument list */
+    template<typename... I>
+    explicit StoragePolicyOwningSingleBlock(I... i) :
+        StoragePolicyOwningSingleBlock(MemoryResources::getDefaultResource(), i...)
+    {
+    }
+    
+    /** Constructor that takes the resource to draw the memory block from, followed by the extents of the dimensions */
+    template<class Resource, typename... I, std::enable_if_t<std::is_base_of<MemoryResource, Resource>::value, int> = 0>
+    StoragePolicyOwningSingleBlock(Resource* memoryResource, I... i) :
+        m_bufferGeometry(BufferGeometry<N>(i...).withAlignedRows(RowAlignment)),
+        m_block(allocateBlock(memoryResource, m_bufferGeometry))
+    {
+        ASSERT(CompiletimeMath::areAllPositive(i...), "Invalid Dimension extents");
+        std::uninitialized_fill_n(getRawData(), m_bufferGeometry.getRequiredDataArraySize(), T());
+        m_bufferGeometry.hookupPointerArrayToData(getRawData(), getPointers());
+    }
+    
+    ~StoragePolicyOwningSingleBlock()
+    {
+        destroyData();
+    }
+    
+    // MARK: copying requires the pointers to be hooked up to the copied data (moving leaves the data in place)
+    StoragePolicyOwningSingleBlock(const StoragePolicyOwningSingleBlock& other) :
+        StoragePolicyOwningSingleBlock(other, other.getMemoryResource())
+    {
+    }
+    
+    StoragePolicyOwningSingleBlock& operator=(const StoragePolicyOwningSingleBlock& other)
+    {
+        if (this == &other) {
+            return *this;
+        }
+        if (m_bufferGeometry.getRequiredDataArraySize() == other.m_bufferGeometry.getRequiredDataArraySize() &&
+            m_bufferGeometry.getRequiredPointerArraySize() == other.m_bufferGeometry.getRequiredPointerArraySize()) {
+            // same memory layout: re-use the existing block
+            m_bufferGeometry = other.m_bufferGeometry;
+            std::copy_n(other.getRawData(), m_bufferGeometry.getRequiredDataArraySize(), getRawData());
+            m_bufferGeometry.hookupPointerArrayToData(getRawData(), getPointers());
+        } else {
+            StoragePolicyOwningSingleBlock copy(other, getMemoryResource()); // keep our resource
+            *this = std::move(copy);
+        }
+        return *this;
+    }
+    
+    StoragePolicyOwningSingleBlock(StoragePolicyOwningSingleBlock&& other) noexcept :
+        m_bufferGeometry(other.m_bufferGeometry),
+        m_block(std::move(other.m_block))
+    {
+    }
+    
+    StoragePolicyOwningSingleBlock& operator=(StoragePolicyOwningSingleBlock&& other) noexcept
+    {
+        if (this != &other) {
+            destroyData();
+            m_bufferGeometry = other.m_bufferGeometry;
+            m_block = std::move(other.m_block);
+        }
+        return *this;
+    }
+    
+    /** @return a modifiable pointer to a subdimension of the data */
+    T* getSubDimData(size_type index) const
+    {
+        const offset_type offset = m_bufferGeometry.getDataArrayOffsetForHighestOrderSubDim(index);
+        return getRawData() + offset;
+    }
+    
+    /** @return the storage for a (non-owning) view to a subdimension, which borrows a slice of the pointer array */
+    SubBufferPolicy getSubDimStorage(size_type index) const
+    {
+        auto pointers = reinterpret_cast<pointer_type>(getPointers());
+        return SubBufferPolicy(pointers[index], getSubDimData(index), m_bufferGeometry.getSubDimGeometry());
+    }
+    
+    int size(int i) const { ASSERT(i < N); return m_bufferGeometry.getDimensionExtents()[i]; }
+    const std::array<int, N>& sizes() const noexcept { return m_bufferGeometry.getDimensionExtents(); }
+    const BufferGeometry<N>& getGeometry() const noexcept { return m_bufferGeometry; }
+    
+    /** @return a modifiable pointer to the start of the flat (1D) data */
+    T* getFlatData() const noexcept { return getRawData(); }
+    
+    /** @return the resource the memory block is drawn from */
+    MemoryResource* getMemoryResource() const noexcept { return m_block.get_deleter().memoryResource; }
+
+    const_pointer_type getDataPointer_Nx() const noexcept { return reinterpret_cast<const_pointer_type>(getPointers()); }
+          pointer_type getDataPointer_Nx()       noexcept { return reinterpret_cast<pointer_type>(getPointers()); }
+              const T* getDataPointer_N1() const noexcept { return getRawData(); }
+                    T* getDataPointer_N1()       noexcept { return getRawData(); }
+    
+    /** @return the size in bytes of the block that holds both pointers and data */
+    static std::size_t getBlockSize(const BufferGeometry<N>& geometry) noexcept
+    {
+        return getDataOffsetInBlock(geometry) + static_cast<std::size_t>(geometry.getRequiredDataArraySize()) * sizeof(T);
+    }
+
+private:
+    /** Copy constructor that draws the new block from the given resource */
+    StoragePolicyOwningSingleBlock(const StoragePolicyOwningSingleBlock& other, MemoryResource* memoryResource) :
+        m_bufferGeometry(other.m_bufferGeometry),
+        m_block(allocateBlock(memoryResource, m_bufferGeometry))
+    {
+        std::uninitialized_copy_n(other.getRawData(), m_bufferGeometry.getRequiredDataArraySize(), getRawData());
+        m_bufferGeometry.hookupPointerArrayToData(getRawData(), getPointers());
+    }
+    
+    /** @return the offset in bytes of the data in the block: the data follows the pointers (plus alignment padding) */
+    static std::size_t getDataOffsetInBlock(const BufferGeometry<N>& geometry) noexcept
+    {
+        const std::size_t pointerBytes = static_cast<std::size_t>(geometry.getRequiredPointerArraySize()) * sizeof(T*);
+        return ((pointerBytes + Alignment - 1) / Alignment) * Alignment;
+    }
+    
+    struct BlockDeleter
+    {
+        MemoryResource* memoryResource;
+        std::size_t blockSize;
+        void operator()(unsigned char* block) const noexcept { memoryResource->deallocate(block, blockSize, BlockAlignment); }
+    };
+    using BlockPointer = std::unique_ptr<unsigned char, BlockDeleter>;
+    
+    static BlockPointer allocateBlock(MemoryResource* memoryResource, const BufferGeometry<N>& geometry)
+    {
+        ASSERT(memoryResource != nullptr);
+        const std::size_t blockSize = getBlockSize(geometry);
+        auto block = static_cast<unsigned char*>(memoryResource->allocate(blockSize, BlockAlignment));
+        return BlockPointer(block, BlockDeleter { memoryResource, blockSize });
+    }
+    
+    T** getPointers() const noexcept
+    {
+        return reinterpret_cast<T**>(m_block.get());
+    }
+    
+    T* getRawData() const noexcept
+    {
+        return reinterpret_cast<T*>(m_block.get() + getDataOffsetInBlock(m_bufferGeometry));
+    }
+    
+    void destroyData() noexcept
+    {
+        if (m_block == nullptr) {
+            return; // moved-from
+        }
+        T* data = getRawData();
+        for (offset_type i = 0; i < m_bufferGeometry.getRequiredDataArraySize(); ++i) {
+            data[i].~T();
+        }
+    }
+
+private:
+    /** Handles the geometry (organization) of the data memory, enabling multi-dimensional access to it */
+    BufferGeometry<N> m_bufferGeometry;
+    
+    /** Single block of memory: the pointers for all but the innermost dimension, followed by all the data */
+    BlockPointer m_block;
+};
+
 // ====================================================================================================================
 /**
  *  A wrapper for existing HyperBuffer data in its native format, which gives it the same API, but without data ownership.
  *  The extents of the dimensions have to be supplied during construction.
  *
  *  The pre-allocated data is expected to be in a flat (one-dimensional), contiguous memory block. Pointer memory is
- *  allocated during construction and, unlike data memory, is owned by a given instance of this class.
+ *  allocated during construction and, unlike data memory, is owned by a given instance of this class. It is drawn from
+ *  a MemoryResource, which can be passed to the constructor ahead of the data (otherwise, the default resource is used).
  *
  *  - Template parameters: T=data type (e.g. float),  N=dimension (e.g. 3)
  */
@@ -107,24 +360,52 @@ class StoragePolicyView
     using const_pointer_type        = typename add_const_pointers_to_type<T, N>::type;
     
 public:
-    using SubBufferPolicy = StoragePolicyView<T, N-1>;
+    using SubBufferPolicy = StoragePolicySubView<T, N-1>;
+    static constexpr bool IsContiguous = true;
     
     /** Constructor that takes the extents of the dimensions as a variable argument list */
     template<typename... I>
     StoragePolicyView(T* preAllocatedDataFlat, I... i) :
+        StoragePolicyView(MemoryResources::getDefaultResource(), preAllocatedDataFlat, i...)
+    {
+    }
+    
+    /** Constructor that takes the resource to draw the pointer memory from, the data and the extents of the dimensions */
+    template<class Resource, typename... I, std::enable_if_t<std::is_base_of<MemoryResource, Resource>::value, int> = 0>
+    StoragePolicyView(Resource* memoryResource, T* preAllocatedDataFlat, I... i) :
         m_bufferGeometry(i...),
         m_externalData(preAllocatedDataFlat),
-        m_pointers(m_bufferGeometry.getRequiredPointerArraySize())
+        m_pointers(m_bufferGeometry.getRequiredPointerArraySize(), PointerAllocator(memoryResource))
     {
         ASSERT(CompiletimeMath::areAllPositive(i...), "Invalid Dimension extents");
         ASSERT(m_externalData != nullptr);
         m_bufferGeometry.hookupPointerArrayToData(m_externalData, m_pointers.data());
     }
+    
+    /** Constructor that takes a (possibly padded) geometry that describes the layout of the data */
+    StoragePolicyView(T* preAllocatedDataFlat, const BufferGeometry<N>& bufferGeometry) :
+        StoragePolicyView(MemoryResources::getDefaultResource(), preAllocatedDataFlat, bufferGeometry)
+    {
+    }
+    
+    /** Constructor that takes the resource to draw the pointer memory from, the data and its (possibly padded) geometry */
+    template<class Resource, std::enable_if_t<std::is_base_of<MemoryResource, Resource>::value, int> = 0>
+    StoragePolicyView(Resource* memoryResource, T* preAllocatedDataFlat, const BufferGeometry<N>& bufferGeometry) :
+        m_bufferGeometry(bufferGeometry),
+        m_externalData(preAllocatedDataFlat),
+        m_pointers(m_bufferGeometry.getRequiredPointerArraySize(), PointerAllocator(memoryResource))
+    {
+        ASSERT(m_externalData != nullptr);
+        m_bufferGeometry.hookupPointerArrayToData(m_externalData, m_pointers.data());
+    }
 
-    /** Constructor that takes an existing (owning) Buffer and creates a (non-owning) View from it */
-    explicit StoragePolicyView(StoragePolicyOwning<T, N>& owningBufferPolicy) :
-        m_bufferGeometry(owningBufferPolicy.sizes()),
-        m_externalData(owningBufferPolicy.getRawData()),
+    /** Constructor that takes an existing Buffer with contiguous data (e.g. 'owning') and creates a (non-owning) View from it */
+    template<class ContiguousStoragePolicy, std::enable_if_t<ContiguousStoragePolicy::IsContiguous &&
+                                                             !std::is_same<ContiguousStoragePolicy, StoragePolicyView>::value, int> = 0>
+    explicit StoragePolicyView(ContiguousStoragePolicy& contiguousBufferPolicy) :
+        m_bufferGeometry(contiguousBufferPolicy.getGeometry().getDimensionExtents(),
+                         contiguousBufferPolicy.getGeometry().getInnermostStride()),
+        m_externalData(contiguousBufferPolicy.getFlatData()),
         m_pointers(m_bufferGeometry.getRequiredPointerArraySize())
     {
         m_bufferGeometry.hookupPointerArrayToData(m_externalData, m_pointers.data());
@@ -133,27 +414,209 @@ public:
     /** @return a modifiable pointer to a subdimension of the data */
     T* getSubDimData(size_type index) const
     {
-        const int offset = m_bufferGeometry.getDataArrayOffsetForHighestOrderSubDim(index);
+        const offset_type offset = m_bufferGeometry.getDataArrayOffsetForHighestOrderSubDim(index);
         return &m_externalData[offset];
     }
     
+    /** @return the storage for a view to a subdimension of the data, which borrows a slice of the pointer array */
+    SubBufferPolicy getSubDimStorage(size_type index) const
+    {
+        return SubBufferPolicy(getPointers()[index], getSubDimData(index), m_bufferGeometry.getSubDimGeometry());
+    }
+    
     int size(int i) const { ASSERT(i < N); return m_bufferGeometry.getDimensionExtents()[i]; }
     const std::array<int, N>& sizes() const noexcept { return m_bufferGeometry.getDimensionExtents(); }
+    const BufferGeometry<N>& getGeometry() const noexcept { return m_bufferGeometry; }
+    
+    /** @return a modifiable pointer to the start of the flat (1D) data */
+    T* getFlatData() const noexcept { return m_externalData; }
+    
+    /** @return the resource the pointer memory is drawn from */
+    MemoryResource* getMemoryResource() const noexcept { return m_pointers.get_allocator().getResource(); }
 
-    const_pointer_type getDataPointer_Nx() const noexcept { return reinterpret_cast<const_pointer_type>(m_pointers.data()); }
-          pointer_type getDataPointer_Nx()       noexcept { return reinterpret_cast<pointer_type>(m_pointers.data()); }
+    const_pointer_type getDataPointer_Nx() const noexcept { return getPointers(); }
+          pointer_type getDataPointer_Nx()       noexcept { return getPointers(); }
               const T* getDataPointer_N1() const noexcept { return *m_pointers.data(); }
                     T* getDataPointer_N1()       noexcept { return *m_pointers.data(); }
     
 private:
+    /** @return the pointer array as N-dimensional pointer (cast via void*, which is also valid for a const T) */
+    pointer_type getPointers() const noexcept
+    {
+        return static_cast<pointer_type>(static_cast<void*>(const_cast<T**>(m_pointers.data())));
+    }
+    
     /** Handles the geometry (organization) of the data memory, enabling multi-dimensional access to it */
     BufferGeometry<N> m_bufferGeometry;
     
     /** Pointer to the externally-allocated data memory */
     T* m_externalData;
     
+    using PointerAllocator = AlignedAllocator<T*>;
+    
     /** All but the innermost dimensions consist of pointers only, which are stored in a 1D structure as well */
-    std::vector<T*> m_pointers;
+    std::vector<T*, PointerAllocator> m_pointers;
+};
+
+// ====================================================================================================================
+/**
+ *  Memory model for HyperBuffers whose extents are known at compile time: full ownership of data and pointer memory,
+ *  both of which are stored inline in the object (no dynamic memory allocation at all). All geometry calculations
+ *  are resolved at compile time.
+ *
+ *  @note Since the pointer array references the object itself, copying/moving re-connects the pointers.
+ *
+ *  - Template parameters: T=data type (e.g. float),  Extents=extents of the dimensions (e.g. 2, 512)
+ */
+template<typename T, int... Extents>
+class StoragePolicyStatic
+{
+    static constexpr int N = sizeof...(Extents);
+    using size_type                 = int;
+    using pointer_type              = typename add_pointers_to_type<T, N>::type;
+    using const_pointer_type        = typename add_const_pointers_to_type<T, N>::type;
+    using Geometry                  = StaticBufferGeometry<Extents...>;
+    
+    static_assert(CompiletimeMath::areAllPositive(Extents...), "Invalid Dimension extents");
+    static_assert(std::is_nothrow_move_constructible<T>::value && std::is_nothrow_move_assignable<T>::value,
+                  "Data type must be nothrow-movable");
+
+public:
+    using SubBufferPolicy = StoragePolicySubView<T, N-1>;
+    static constexpr bool IsContiguous = true;
+    
+    StoragePolicyStatic() : m_data{}
+    {
+        Geometry::hookupPointerArrayToData(m_data.data(), m_pointers.data());
+    }
+    
+    ~StoragePolicyStatic() = default;
+    
+    StoragePolicyStatic(const StoragePolicyStatic& other) : m_data(other.m_data)
+    {
+        Geometry::hookupPointerArrayToData(m_data.data(), m_pointers.data());
+    }
+    
+    StoragePolicyStatic(StoragePolicyStatic&& other) noexcept : m_data(std::move(other.m_data))
+    {
+        Geometry::hookupPointerArrayToData(m_data.data(), m_pointers.data());
+    }
+    
+    // MARK: assignment only concerns the data -- the pointers already reference the data of this instance
+    StoragePolicyStatic& operator=(const StoragePolicyStatic& other)
+    {
+        m_data = other.m_data;
+        return *this;
+    }
+    
+    StoragePolicyStatic& operator=(StoragePolicyStatic&& other) noexcept
+    {
+        m_data = std::move(other.m_data);
+        return *this;
+    }
+    
+    /** @return a modifiable pointer to a subdimension of the data */
+    T* getSubDimData(size_type index) const
+    {
+        return getFlatData() + Geometry::getDataArrayOffsetForHighestOrderSubDim(index);
+    }
+    
+    /** @return the storage for a (non-owning) view to a subdimension, which borrows a slice of the pointer array */
+    SubBufferPolicy getSubDimStorage(size_type index) const
+    {
+        auto pointers = reinterpret_cast<pointer_type>(const_cast<T**>(m_pointers.data()));
+        return SubBufferPolicy(pointers[index], getSubDimData(index), Geometry::getSubDimGeometry());
+    }
+    
+    int size(int i) const { ASSERT(i < N); return Geometry::getDimensionExtents()[i]; }
+    const std::array<int, N>& sizes() const noexcept { return Geometry::getDimensionExtents(); }
+    constexpr Geometry getGeometry() const noexcept { return {}; }
+    
+    /** @return a modifiable pointer to the start of the flat (1D) data */
+    T* getFlatData() const noexcept { return const_cast<T*>(m_data.data()); }
+
+    const_pointer_type getDataPointer_Nx() const noexcept { return reinterpret_cast<const_pointer_type>(m_pointers.data()); }
+          pointer_type getDataPointer_Nx()       noexcept { return reinterpret_cast<pointer_type>(m_pointers.data()); }
+              const T* getDataPointer_N1() const noexcept { return m_data.data(); }
+                    T* getDataPointer_N1()       noexcept { return m_data.data(); }
+    
+private:
+    /** All the data (innermost dimension), stored inline */
+    std::array<T, static_cast<std::size_t>(Geometry::getRequiredDataArraySize())> m_data;
+    
+    /** All but the innermost dimensions consist of pointers only, stored inline as well */
+    std::array<T*, static_cast<std::size_t>(Geometry::getRequiredPointerArraySize())> m_pointers;
+};
+
+// ====================================================================================================================
+/**
+ *  A view to a sub-dimension of a buffer in the native format (i.e. of a StoragePolicyOwning or StoragePolicyView).
+ *  Both pointer and data memory are stored externally (this class has no ownership): the pointers are a slice of the
+ *  parent's self-referencing pointer array, which already holds all the pointers required by any sub-dimension.
+ *
+ *  Creating, copying and moving instances of this class never allocates memory.
+ *
+ *  @note The pointer memory is borrowed from the parent, which therefore has to outlive any instance of this class.
+ *
+ *  - Template parameters: T=data type (e.g. float),  N=dimension (e.g. 3)
+ */
+template<typename T, int N>
+class StoragePolicySubView
+{
+    using size_type                 = int;
+    using pointer_type              = typename add_pointers_to_type<T, N>::type;
+    using const_pointer_type        = typename add_const_pointers_to_type<T, N>::type;
+    using subdim_pointer_type       = typename remove_pointers_from_type<pointer_type, 1>::type;
+    
+public:
+    using SubBufferPolicy = StoragePolicySubView<T, N-1>;
+    static constexpr bool IsContiguous = true;
+    
+    /**
+     * Constructor that takes the borrowed pointers, the start of the (flat) data they point to and the geometry
+     * that describes the data layout.
+     */
+    StoragePolicySubView(pointer_type borrowedPointers, T* dataFlat, const BufferGeometry<N>& bufferGeometry) :
+        m_bufferGeometry(bufferGeometry),
+        m_externalData(dataFlat),
+        m_externalPointers(borrowedPointers)
+    {
+    }
+    
+    /** @return a modifiable pointer to a subdimension of the data */
+    T* getSubDimData(size_type index) const
+    {
+        const offset_type offset = m_bufferGeometry.getDataArrayOffsetForHighestOrderSubDim(index);
+        return &m_externalData[offset];
+    }
+    
+    /** @return the storage for a view to a subdimension of the data, which borrows a slice of the pointer array */
+    SubBufferPolicy getSubDimStorage(size_type index) const
+    {
+        return SubBufferPolicy(m_externalPointers[index], getSubDimData(index), m_bufferGeometry.getSubDimGeometry());
+    }
+    
+    int size(int i) const { ASSERT(i < N); return m_bufferGeometry.getDimensionExtents()[i]; }
+    const std::array<int, N>& sizes() const noexcept { return m_bufferGeometry.getDimensionExtents(); }
+    const BufferGeometry<N>& getGeometry() const noexcept { return m_bufferGeometry; }
+    
+    /** @return a modifiable pointer to the start of the flat (1D) data */
+    T* getFlatData() const noexcept { return m_externalData; }
+
+    const_pointer_type getDataPointer_Nx() const noexcept { return m_externalPointers; }
+          pointer_type getDataPointer_Nx()       noexcept { return m_externalPointers; }
+              const T* getDataPointer_N1() const noexcept { return m_externalData; }
+                    T* getDataPointer_N1()       noexcept { return m_externalData; }
+    
+private:
+    /** Handles the geometry (organization) of the data memory */
+    BufferGeometry<N> m_bufferGeometry;
+    
+    /** Pointer to the start of the externally-allocated data memory */
+    T* m_externalData;
+    
+    /** Pointer to the borrowed (externally-allocated) pointer memory */
+    pointer_type m_externalPointers;
 };
 
 // ====================================================================================================================
@@ -177,6 +640,7 @@ class StoragePolicyViewNonContiguous
     
 public:
     using SubBufferPolicy = StoragePolicyViewNonContiguous<T, N-1>;
+    static constexpr bool IsContiguous = false;
     
     /** Constructor that takes the extents of the dimensions as a variable argument list */
     template<typename... I>
@@ -209,6 +673,12 @@ public:
     {
         return m_externalData[index];
     }
+    
+    /** @return the storage for a (non-owning) view to a subdimension of the data */
+    SubBufferPolicy getSubDimStorage(size_type index) const
+    {
+        return SubBufferPolicy(getSubDimData(index), StdArrayOperations::shaveOffFirstElement(m_dimensionExtents));
+    }
 
     int size(int i) const { ASSERT(i < N); return m_dimensionExtents[i]; }
     const std::array<int, N>& sizes() const noexcept { return m_dimensionExtents; }
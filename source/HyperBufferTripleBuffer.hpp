@@ -0,0 +1,102 @@
+//
+//  ╦ ╦┬ ┬┌─┐┌─┐┬─┐  ╔╗ ┬ ┬┌─┐┌─┐┌─┐┬─┐
+//  ╠═╣└┬┘├─┘├┤ ├┬┘  ╠╩╗│ │├┤ ├┤ ├┤ ├┬┘
+//  ╩ ╩ ┴ ┴  └─┘┴└─  ╚═╝└─┘└  └  └─┘┴└─
+//
+//  © 2023 Lorenz Bucher - all rights reserved
+//  https://github.com/Sidelobe/HyperBuffer
+
+#pragma once
+
+#include <array>
+#include <atomic>
+
+#include "HyperBuffer.hpp"
+
+namespace slb
+{
+
+/**
+ *  Wait-free triple buffer of three HyperBuffers of identical geometry, to publish state (e.g. a bank of filter
+ *  coefficients) from one writer thread to one reader thread. The writer always has a buffer to fill, the reader
+ *  always gets the latest completely written one - neither of them ever waits for the other:
+ *
+ *      // writer thread                                // reader thread
+ *      auto& coefficients = state.getWriteBuffer();    const auto& coefficients = state.acquireRead();
+ *      computeCoefficients(coefficients);              applyFilter(coefficients, audio);
+ *      state.publish();
+ *
+ *  The three buffers take the roles of the writer's back buffer, the reader's front buffer and the latest published
+ *  buffer in between. publish() swaps the back buffer with the middle one, acquireRead() swaps the front buffer with
+ *  the middle one if it has been published since. States published in between two reads are skipped.
+ *
+ *  - Guarantees: no allocation, no locks and no system calls after construction; all operations are wait-free.
+ *  - Threading: getWriteBuffer()/publish()/write() must be called from one (writer) thread only,
+ *    acquireRead()/hasNewData() from one (reader) thread only.
+ *  - Note: the back buffer handed out by getWriteBuffer() contains an outdated state, not the last published one.
+ *
+ *  - Template parameters: T=data type (e.g. float),  N=dimension (e.g. 3), StoragePolicy of the buffers
+ */
+template<typename T, int N, class StoragePolicy = StoragePolicyOwning<T, N>>
+class HyperBufferTripleBuffer
+{
+public:
+    using Buffer = HyperBuffer<T, N, StoragePolicy>;
+
+    /** Constructor that forwards its arguments to the constructor of each of the three buffers */
+    template<typename... I>
+    explicit HyperBufferTripleBuffer(I... i) : m_buffers {{ Buffer(i...), Buffer(i...), Buffer(i...) }} {}
+
+    // MARK: the buffers are shared between two threads: neither copyable nor movable
+    HyperBufferTripleBuffer(const HyperBufferTripleBuffer&) = delete;
+    HyperBufferTripleBuffer& operator=(const HyperBufferTripleBuffer&) = delete;
+
+    // MARK: - Writer
+
+    /** @returns the back buffer, to be filled and then handed to the reader with publish() */
+    Buffer& getWriteBuffer() noexcept { return m_buffers[m_backIndex]; }
+
+    /** Makes the back buffer the latest state; the writer continues with a different buffer */
+    void publish() noexcept
+    {
+        m_backIndex = m_middle.exchange(m_backIndex | DirtyFlag, std::memory_order_acq_rel) & IndexMask;
+    }
+
+    /** Copies the source into the back buffer and publishes it */
+    template<class SrcStoragePolicy>
+    void write(const HyperBuffer<T, N, SrcStoragePolicy>& source)
+    {
+        BufferOperations::copy(getWriteBuffer(), source);
+        publish();
+    }
+
+    // MARK: - Reader
+
+    /** @returns true if a state has been published since the last call to acquireRead() */
+    bool hasNewData() const noexcept { return (m_middle.load(std::memory_order_relaxed) & DirtyFlag) != 0; }
+
+    /**
+     * @returns the latest published state (the initial contents of the buffers if nothing has been published yet).
+     * The reference remains valid and the buffer is not modified until the next call to acquireRead().
+     */
+    const Buffer& acquireRead() noexcept
+    {
+        if (hasNewData()) {
+            m_frontIndex = m_middle.exchange(m_frontIndex, std::memory_order_acq_rel) & IndexMask;
+        }
+        return m_buffers[m_frontIndex];
+    }
+
+private:
+    /** The middle index carries a flag that signals a state that has not been read yet */
+    static constexpr unsigned DirtyFlag = 4;
+    static constexpr unsigned IndexMask = 3;
+
+    std::array<Buffer, 3> m_buffers;
+
+    alignas(CacheLineSize) unsigned m_backIndex = 0;               // owned by the writer
+    alignas(CacheLineSize) std::atomic<unsigned> m_middle { 1 };   // shared
+    alignas(CacheLineSize) unsigned m_frontIndex = 2;              // owned by the reader
+};
+
+} // namespace slb
@@ -57,16 +57,26 @@ constexpr int sumOfCumulativeProductCapped(int cap, const std::array<int, N>& ar
 }
 
 /** @returns the N-1 sub-array : removes / "shaves off" the first element */
-template<std::size_t N>
-constexpr std::array<int, N-1> shaveOffFirstElement(const std::array<int, N>& array) noexcept
+template<typename T, std::size_t N>
+constexpr std::array<T, N-1> shaveOffFirstElement(const std::array<T, N>& array) noexcept
 {
-    std::array<int, N-1> subarray;
+    std::array<T, N-1> subarray;
     for (int i=0; i < N-1; ++i) {
         subarray[i] = array[i+1];
     }
     return subarray;
 }
 
+/** @returns the N-1 sub-array : removes the element at the given index */
+template<typename T, std::size_t N>
+constexpr std::array<T, N-1> removeElement(const std::array<T, N>& array, int index) noexcept
+{
+    std::array<T, N-1> subarray;
+    for (int i=0; i < N-1; ++i) {
+        subarray[i] = array[(i < index) ? i : i+1];
+    }
+    return subarray;
+}
 
 } // namespace StdArrayOperations
 } // namespace slb
@@ -0,0 +1,284 @@
+//
+//  ╦ ╦┬ ┬┌─┐┌─┐┬─┐  ╔╗ ┬ ┬┌─┐┌─┐┌─┐┬─┐
+//  ╠═╣└┬┘├─┘├┤ ├┬┘  ╠╩╗│ │├┤ ├┤ ├┤ ├┬┘
+//  ╩ ╩ ┴ ┴  └─┘┴└─  ╚═╝└─┘└  └  └─┘┴└─
+//
+//  © 2023 Lorenz Bucher - all rights reserved
+//  https://github.com/Sidelobe/HyperBuffer
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+
+#if defined(_WIN32)
+  #ifndef NOMINMAX
+    #define NOMINMAX
+  #endif
+  #ifndef WIN32_LEAN_AND_MEAN
+    #define WIN32_LEAN_AND_MEAN
+  #endif
+  #include <windows.h>
+#else
+  #include <fcntl.h>
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+  #include <unistd.h>
+#endif
+
+#include "TemplateUtils.hpp"
+
+namespace slb
+{
+
+/**
+ * A range of a file mapped into memory (POSIX `mmap`, Win32 `MapViewOfFile`). The file is mapped on construction and
+ * unmapped on destruction. Mapping is instantaneous regardless of the size of the range: the OS pages the data in
+ * lazily, upon first access.
+ *
+ * The start of the range does not need to be aligned to a page boundary: the mapping is extended to the preceding
+ * boundary internally, and `data()` points to the first byte of the requested range.
+ *
+ * Instances can be moved, but not copied.
+ */
+class MappedFile
+{
+public:
+    enum class Mode
+    {
+        ReadOnly,       ///< the file must exist and be large enough; the memory must not be written to
+        ReadWrite,      ///< the file is created and/or extended if needed; modifications are written back to the file
+        CopyOnWrite     ///< the file must exist and be large enough; modifications are private to this mapping
+    };
+
+    /** Hints about the expected access pattern, which help the OS to page in data ahead of time */
+    enum class AccessHint
+    {
+        Normal,         ///< no particular pattern (default)
+        Sequential,     ///< aggressive read-ahead, pages can be freed soon after they have been accessed
+        Random,         ///< no read-ahead
+        WillNeed        ///< start paging in the whole range now
+    };
+
+    /** Options for mapping a file into a buffer @see StoragePolicyMapped */
+    struct Options
+    {
+        Mode mode = Mode::ReadOnly;
+        std::size_t offset = 0;                 ///< position of the first element in the file, in bytes
+        AccessHint hint = AccessHint::Normal;
+    };
+
+    MappedFile() noexcept = default;
+
+    /**
+     * Maps `length` bytes of the file at `path`, starting at byte `offset`. A length of 0 maps the rest of the file.
+     * @note fails (ASSERT) if the file cannot be opened or mapped, or if it is too short for the requested range
+     * (unless mode is ReadWrite, in which case the file is extended).
+     */
+    MappedFile(const std::string& path, Mode mode, std::size_t offset = 0, std::size_t length = 0) : m_mode(mode)
+    {
+        map(path, offset, length);
+    }
+
+    ~MappedFile() { unmap(); }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    MappedFile(MappedFile&& other) noexcept :
+        m_mapping(std::exchange(other.m_mapping, nullptr)),
+        m_mappingLength(std::exchange(other.m_mappingLength, 0)),
+        m_data(std::exchange(other.m_data, nullptr)),
+        m_size(std::exchange(other.m_size, 0)),
+        m_mode(other.m_mode)
+    {
+    }
+
+    MappedFile& operator=(MappedFile&& other) noexcept
+    {
+        if (this != &other) {
+            unmap();
+            m_mapping = std::exchange(other.m_mapping, nullptr);
+            m_mappingLength = std::exchange(other.m_mappingLength, 0);
+            m_data = std::exchange(other.m_data, nullptr);
+            m_size = std::exchange(other.m_size, 0);
+            m_mode = other.m_mode;
+        }
+        return *this;
+    }
+
+    /** @return the first byte of the mapped range */
+    void* data() const noexcept { return m_data; }
+
+    /** @return the length of the mapped range, in bytes */
+    std::size_t size() const noexcept { return m_size; }
+
+    Mode getMode() const noexcept { return m_mode; }
+    bool isMapped() const noexcept { return m_mapping != nullptr; }
+
+    /** Passes a hint about the expected access pattern to the OS (best effort: failures are ignored) */
+    void advise(AccessHint hint) const noexcept
+    {
+        if (!isMapped()) {
+            return;
+        }
+#if defined(_WIN32)
+  #if defined(_WIN32_WINNT) && (_WIN32_WINNT >= 0x0602) // Windows 8
+        if (hint == AccessHint::WillNeed) {
+            WIN32_MEMORY_RANGE_ENTRY range { m_mapping, m_mappingLength };
+            PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+        }
+  #else
+        UNUSED(hint); // no equivalent on older versions of Windows
+  #endif
+#else
+        int advice = MADV_NORMAL;
+        switch (hint) {
+            case AccessHint::Normal:     advice = MADV_NORMAL;     break;
+            case AccessHint::Sequential: advice = MADV_SEQUENTIAL; break;
+            case AccessHint::Random:     advice = MADV_RANDOM;     break;
+            case AccessHint::WillNeed:   advice = MADV_WILLNEED;   break;
+        }
+        ::madvise(m_mapping, m_mappingLength, advice);
+#endif
+    }
+
+    /** Synchronously writes modified pages back to the file (ReadWrite mode only, no-op otherwise) */
+    void flush() const
+    {
+        if (!isMapped() || m_mode != Mode::ReadWrite) {
+            return;
+        }
+#if defined(_WIN32)
+        const bool flushed = (FlushViewOfFile(m_mapping, 0) != 0);
+        ASSERT(flushed, "Cannot flush mapped file");
+#else
+        const bool flushed = (::msync(m_mapping, m_mappingLength, MS_SYNC) == 0);
+        ASSERT(flushed, "Cannot flush mapped file");
+#endif
+    }
+
+private:
+#if defined(_WIN32)
+    /** Closes the handle when going out of scope (also if mapping fails) */
+    struct ScopedHandle
+    {
+        HANDLE handle;
+        ~ScopedHandle() { if (handle != nullptr && handle != INVALID_HANDLE_VALUE) { CloseHandle(handle); } }
+    };
+
+    void map(const std::string& path, std::size_t offset, std::size_t length)
+    {
+        const bool readWrite = (m_mode == Mode::ReadWrite);
+        ScopedHandle file { CreateFileA(path.c_str(), readWrite ? (GENERIC_READ | GENERIC_WRITE) : GENERIC_READ,
+                                        FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr,
+                                        readWrite ? OPEN_ALWAYS : OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr) };
+        ASSERT(file.handle != INVALID_HANDLE_VALUE, "Cannot open file");
+
+        LARGE_INTEGER fileSize;
+        const bool hasSize = (GetFileSizeEx(file.handle, &fileSize) != 0);
+        ASSERT(hasSize, "Cannot determine file size");
+        length = resolveLength(static_cast<std::uint64_t>(fileSize.QuadPart), offset, length);
+
+        // the mapping object extends the file if it is too short (ReadWrite only)
+        const std::uint64_t end = std::uint64_t{offset} + length;
+        const DWORD protection = (m_mode == Mode::ReadOnly) ? PAGE_READONLY : (readWrite ? PAGE_READWRITE : PAGE_WRITECOPY);
+        ScopedHandle mapping { CreateFileMappingA(file.handle, nullptr, protection,
+                                                  static_cast<DWORD>(end >> 32), static_cast<DWORD>(end & 0xFFFFFFFFu), nullptr) };
+        ASSERT(mapping.handle != nullptr, "Cannot map file");
+
+        SYSTEM_INFO systemInfo;
+        GetSystemInfo(&systemInfo);
+        const std::uint64_t alignedOffset = offset - offset % systemInfo.dwAllocationGranularity;
+        const DWORD access = (m_mode == Mode::ReadOnly) ? FILE_MAP_READ : (readWrite ? FILE_MAP_WRITE : FILE_MAP_COPY);
+        const std::size_t mappingLength = length + static_cast<std::size_t>(offset - alignedOffset);
+        void* view = MapViewOfFile(mapping.handle, access, static_cast<DWORD>(alignedOffset >> 32),
+                                   static_cast<DWORD>(alignedOffset & 0xFFFFFFFFu), mappingLength);
+        ASSERT(view != nullptr, "Cannot map file");
+        // the view keeps the mapping object alive -- both handles can be closed
+        setMapping(view, mappingLength, static_cast<std::size_t>(offset - alignedOffset), length);
+    }
+
+    void unmap() noexcept
+    {
+        if (isMapped()) {
+            UnmapViewOfFile(m_mapping);
+            m_mapping = nullptr;
+        }
+    }
+#else
+    /** Closes the file descriptor when going out of scope (also if mapping fails) */
+    struct ScopedFileDescriptor
+    {
+        int fd;
+        ~ScopedFileDescriptor() { if (fd >= 0) { ::close(fd); } }
+    };
+
+    void map(const std::string& path, std::size_t offset, std::size_t length)
+    {
+        const bool readWrite = (m_mode == Mode::ReadWrite);
+        ScopedFileDescriptor file { ::open(path.c_str(), readWrite ? (O_RDWR | O_CREAT) : O_RDONLY, 0644) };
+        ASSERT(file.fd >= 0, "Cannot open file");
+
+        struct stat fileInfo;
+        const bool hasSize = (::fstat(file.fd, &fileInfo) == 0);
+        ASSERT(hasSize, "Cannot determine file size");
+        length = resolveLength(static_cast<std::uint64_t>(fileInfo.st_size), offset, length);
+
+        const std::uint64_t end = std::uint64_t{offset} + length;
+        if (end > static_cast<std::uint64_t>(fileInfo.st_size)) {
+            const bool extended = (::ftruncate(file.fd, static_cast<off_t>(end)) == 0);
+            ASSERT(extended, "Cannot extend file");
+        }
+
+        const std::size_t pageSize = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+        const std::size_t alignedOffset = offset - offset % pageSize;
+        const std::size_t mappingLength = length + (offset - alignedOffset);
+        void* mapping = ::mmap(nullptr, mappingLength,
+                               (m_mode == Mode::ReadOnly) ? PROT_READ : (PROT_READ | PROT_WRITE),
+                               (m_mode == Mode::CopyOnWrite) ? MAP_PRIVATE : MAP_SHARED,
+                               file.fd, static_cast<off_t>(alignedOffset));
+        ASSERT(mapping != MAP_FAILED, "Cannot map file");
+        // the mapping stays valid after the file descriptor has been closed
+        setMapping(mapping, mappingLength, offset - alignedOffset, length);
+    }
+
+    void unmap() noexcept
+    {
+        if (isMapped()) {
+            ::munmap(m_mapping, m_mappingLength);
+            m_mapping = nullptr;
+        }
+    }
+#endif
+
+    /** @return the length of the range to map, checking it against the size of the file */
+    std::size_t resolveLength(std::uint64_t fileSize, std::size_t offset, std::size_t length) const
+    {
+        if (length == 0) {
+            ASSERT(offset < fileSize, "Offset beyond the end of the file");
+            return fileSize - offset;
+        }
+        ASSERT(m_mode == Mode::ReadWrite || std::uint64_t{offset} + length <= fileSize, "File is too short");
+        return length;
+    }
+
+    void setMapping(void* mapping, std::size_t mappingLength, std::size_t dataOffset, std::size_t size) noexcept
+    {
+        m_mapping = mapping;
+        m_mappingLength = mappingLength;
+        m_data = static_cast<char*>(mapping) + dataOffset;
+        m_size = size;
+    }
+
+private:
+    void* m_mapping = nullptr;          // start of the mapping (aligned to a page boundary)
+    std::size_t m_mappingLength = 0;
+    void* m_data = nullptr;             // start of the requested range, within the mapping
+    std::size_t m_size = 0;
+    Mode m_mode = Mode::ReadOnly;
+};
+
+} // namespace slb
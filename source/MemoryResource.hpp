@@ -0,0 +1,298 @@
+//
+//  ╦ ╦┬ ┬┌─┐┌─┐┬─┐  ╔╗ ┬ ┬┌─┐┌─┐┌─┐┬─┐
+//  ╠═╣└┬┘├─┘├┤ ├┬┘  ╠╩╗│ │├┤ ├┤ ├┤ ├┬┘
+//  ╩ ╩ ┴ ┴  └─┘┴└─  ╚═╝└─┘└  └  └─┘┴└─
+//
+//  © 2023 Lorenz Bucher - all rights reserved
+//  https://github.com/Sidelobe/HyperBuffer
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <new>
+
+#include "TemplateUtils.hpp"
+
+namespace slb
+{
+
+// MARK: - Aligned memory helpers
+namespace AlignedMemory
+{
+
+/** @returns true if the given value is a power of two */
+constexpr bool isPowerOfTwo(std::size_t value) noexcept
+{
+    return value > 0 && (value & (value - 1)) == 0;
+}
+
+/** @returns the smallest multiple of `multiple` that is larger or equal to `value` */
+constexpr int roundUpToMultiple(int value, int multiple) noexcept
+{
+    return ((value + multiple - 1) / multiple) * multiple;
+}
+
+/**
+ * @returns the smallest number of consecutive elements of type T whose combined size is a multiple of `alignment`,
+ * i.e. the granularity (in elements) with which an array of T can be padded to preserve the alignment of its start.
+ */
+template<typename T>
+constexpr int getAlignmentInElements(std::size_t alignment) noexcept
+{
+    int numElements = 1;
+    while ((numElements * sizeof(T)) % alignment != 0) {
+        ++numElements;
+    }
+    return numElements;
+}
+
+/**
+ * Allocates `numBytes` of memory whose start address is a multiple of `alignment`.
+ *
+ * @note For alignments the global operator new already guarantees, the memory is requested as-is. For larger ones,
+ * the memory is over-allocated and the original pointer is stored right in front of the aligned block.
+ */
+inline void* allocate(std::size_t numBytes, std::size_t alignment)
+{
+    ASSERT(isPowerOfTwo(alignment), "Alignment must be a power of two");
+    if (alignment <= alignof(std::max_align_t)) {
+        return ::operator new(numBytes);
+    }
+    void* unaligned = ::operator new(numBytes + alignment - 1 + sizeof(void*));
+    const std::uintptr_t firstUsableAddress = reinterpret_cast<std::uintptr_t>(unaligned) + sizeof(void*);
+    const std::uintptr_t alignedAddress = (firstUsableAddress + alignment - 1) & ~(alignment - 1);
+    void** aligned = reinterpret_cast<void**>(alignedAddress);
+    aligned[-1] = unaligned; // remember where the allocation really starts
+    return aligned;
+}
+
+/** Releases memory obtained with allocate() -- `alignment` must match the one used during allocation */
+inline void deallocate(void* memory, std::size_t alignment) noexcept
+{
+    if (memory == nullptr) {
+        return;
+    }
+    if (alignment <= alignof(std::max_align_t)) {
+        ::operator delete(memory);
+        return;
+    }
+    ::operator delete(static_cast<void**>(memory)[-1]);
+}
+
+} // namespace AlignedMemory
+
+// ====================================================================================================================
+/**
+ *  Source of (aligned) memory for the HyperBuffer storage policies: a C++14-compatible counterpart to
+ *  std::pmr::memory_resource. Derived classes implement doAllocate(), doDeallocate() and doIsEqual().
+ *
+ *  @note A resource is referenced, not owned, by the buffers that use it: it has to outlive all of them.
+ */
+class MemoryResource
+{
+public:
+    virtual ~MemoryResource() = default;
+
+    void* allocate(std::size_t numBytes, std::size_t alignment = alignof(std::max_align_t))
+    {
+        ASSERT(AlignedMemory::isPowerOfTwo(alignment), "Alignment must be a power of two");
+        return doAllocate(numBytes, alignment);
+    }
+
+    void deallocate(void* memory, std::size_t numBytes, std::size_t alignment = alignof(std::max_align_t)) noexcept
+    {
+        doDeallocate(memory, numBytes, alignment);
+    }
+
+    /** @returns true if memory allocated from this resource can be deallocated from the other one, and vice versa */
+    bool isEqual(const MemoryResource& other) const noexcept { return doIsEqual(other); }
+
+private:
+    virtual void* doAllocate(std::size_t numBytes, std::size_t alignment) = 0;
+    virtual void doDeallocate(void* memory, std::size_t numBytes, std::size_t alignment) noexcept = 0;
+    virtual bool doIsEqual(const MemoryResource& other) const noexcept = 0;
+};
+
+inline bool operator==(const MemoryResource& a, const MemoryResource& b) noexcept { return &a == &b || a.isEqual(b); }
+inline bool operator!=(const MemoryResource& a, const MemoryResource& b) noexcept { return !(a == b); }
+
+// MARK: - Global resources
+namespace MemoryResources
+{
+
+/** Resource that uses the global operator new/delete (the default) */
+class NewDelete final : public MemoryResource
+{
+    void* doAllocate(std::size_t numBytes, std::size_t alignment) override
+    {
+        return AlignedMemory::allocate(numBytes, alignment);
+    }
+    void doDeallocate(void* memory, std::size_t numBytes, std::size_t alignment) noexcept override
+    {
+        UNUSED(numBytes);
+        AlignedMemory::deallocate(memory, alignment);
+    }
+    bool doIsEqual(const MemoryResource& other) const noexcept override { return this == &other; }
+};
+
+/** Resource that refuses to allocate: useful as upstream of an arena that must never touch the global heap */
+class Null final : public MemoryResource
+{
+    void* doAllocate(std::size_t numBytes, std::size_t alignment) override
+    {
+        UNUSED(numBytes); UNUSED(alignment);
+#ifdef EXCEPTIONS_DISABLED
+        std::abort();
+#else
+        throw std::bad_alloc();
+#endif
+    }
+    void doDeallocate(void* memory, std::size_t numBytes, std::size_t alignment) noexcept override
+    {
+        UNUSED(memory); UNUSED(numBytes); UNUSED(alignment);
+    }
+    bool doIsEqual(const MemoryResource& other) const noexcept override { return this == &other; }
+};
+
+/** @returns the process-wide resource that uses the global operator new/delete */
+inline MemoryResource* getNewDeleteResource() noexcept
+{
+    static NewDelete resource;
+    return &resource;
+}
+
+/** @returns the process-wide resource that refuses to allocate */
+inline MemoryResource* getNullResource() noexcept
+{
+    static Null resource;
+    return &resource;
+}
+
+inline std::atomic<MemoryResource*>& getDefaultResourceStorage() noexcept
+{
+    static std::atomic<MemoryResource*> defaultResource { getNewDeleteResource() };
+    return defaultResource;
+}
+
+/** @returns the resource used by the storage policies when none is given explicitly */
+inline MemoryResource* getDefaultResource() noexcept
+{
+    return getDefaultResourceStorage().load();
+}
+
+/**
+ * Replaces the default resource (nullptr restores the new/delete resource).
+ * @returns the previous default resource
+ */
+inline MemoryResource* setDefaultResource(MemoryResource* resource) noexcept
+{
+    return getDefaultResourceStorage().exchange(resource != nullptr ? resource : getNewDeleteResource());
+}
+
+} // namespace MemoryResources
+
+// ====================================================================================================================
+/**
+ *  Arena resource that hands out memory by bumping a pointer through an initial buffer (e.g. a pre-reserved block or
+ *  locked memory). Deallocation is a no-op: the memory is only reclaimed by release() or on destruction.
+ *
+ *  When the initial buffer is exhausted, further chunks of geometrically increasing size are requested from the
+ *  upstream resource. Use MemoryResources::getNullResource() as upstream to guarantee the global heap is never used.
+ *
+ *  @note Not thread-safe.
+ */
+class MonotonicBufferResource final : public MemoryResource
+{
+public:
+    explicit MonotonicBufferResource(MemoryResource* upstream = MemoryResources::getDefaultResource()) :
+        MonotonicBufferResource(nullptr, 0, upstream)
+    {
+    }
+
+    MonotonicBufferResource(void* initialBuffer, std::size_t initialSize,
+                            MemoryResource* upstream = MemoryResources::getDefaultResource()) :
+        m_upstream(upstream),
+        m_initialBuffer(initialBuffer),
+        m_initialSize(initialSize),
+        m_current(initialBuffer),
+        m_available(initialSize),
+        m_nextChunkSize(initialSize > MinChunkSize ? 2 * initialSize : MinChunkSize)
+    {
+        ASSERT(m_upstream != nullptr);
+    }
+
+    ~MonotonicBufferResource() override { release(); }
+
+    MonotonicBufferResource(const MonotonicBufferResource&) = delete;
+    MonotonicBufferResource& operator=(const MonotonicBufferResource&) = delete;
+
+    /** Returns all chunks to the upstream resource and starts over at the beginning of the initial buffer */
+    void release() noexcept
+    {
+        while (m_chunks != nullptr) {
+            ChunkHeader* next = m_chunks->next;
+            m_upstream->deallocate(m_chunks, m_chunks->size, alignof(std::max_align_t));
+            m_chunks = next;
+        }
+        m_current = m_initialBuffer;
+        m_available = m_initialSize;
+    }
+
+    MemoryResource* getUpstreamResource() const noexcept { return m_upstream; }
+
+private:
+    struct ChunkHeader
+    {
+        ChunkHeader* next;
+        std::size_t size;
+    };
+    static constexpr std::size_t MinChunkSize = 1024;
+
+    void* doAllocate(std::size_t numBytes, std::size_t alignment) override
+    {
+        if (m_current == nullptr || std::align(alignment, numBytes, m_current, m_available) == nullptr) {
+            addChunk(numBytes + alignment);
+            std::align(alignment, numBytes, m_current, m_available); // cannot fail with the new chunk
+        }
+        void* memory = m_current;
+        m_current = static_cast<unsigned char*>(m_current) + numBytes;
+        m_available -= numBytes;
+        return memory;
+    }
+
+    void doDeallocate(void* memory, std::size_t numBytes, std::size_t alignment) noexcept override
+    {
+        UNUSED(memory); UNUSED(numBytes); UNUSED(alignment); // memory is only reclaimed by release()
+    }
+
+    bool doIsEqual(const MemoryResource& other) const noexcept override { return this == &other; }
+
+    void addChunk(std::size_t minimumUsableSize)
+    {
+        std::size_t chunkSize = sizeof(ChunkHeader) + minimumUsableSize;
+        chunkSize = (chunkSize > m_nextChunkSize) ? chunkSize : m_nextChunkSize;
+        auto chunk = static_cast<ChunkHeader*>(m_upstream->allocate(chunkSize, alignof(std::max_align_t)));
+        chunk->next = m_chunks;
+        chunk->size = chunkSize;
+        m_chunks = chunk;
+        m_current = chunk + 1;
+        m_available = chunkSize - sizeof(ChunkHeader);
+        m_nextChunkSize = 2 * chunkSize;
+    }
+
+private:
+    MemoryResource* m_upstream;
+    void* m_initialBuffer;
+    std::size_t m_initialSize;
+
+    void* m_current;
+    std::size_t m_available;
+    std::size_t m_nextChunkSize;
+    ChunkHeader* m_chunks = nullptr;
+};
+
+} // namespace slb
@@ -0,0 +1,248 @@
+//
+//  ╦ ╦┬ ┬┌─┐┌─┐┬─┐  ╔╗ ┬ ┬┌─┐┌─┐┌─┐┬─┐
+//  ╠═╣└┬┘├─┘├┤ ├┬┘  ╠╩╗│ │├┤ ├┤ ├┤ ├┬┘
+//  ╩ ╩ ┴ ┴  └─┘┴└─  ╚═╝└─┘└  └  └─┘┴└─
+//
+//  © 2023 Lorenz Bucher - all rights reserved
+//  https://github.com/Sidelobe/HyperBuffer
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <ostream>
+#include <string>
+#include <type_traits>
+
+#include "HyperBuffer.hpp"
+#include "HyperBufferMapped.hpp"
+
+namespace slb
+{
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Import/export of HyperBuffers in the NumPy `.npy` format (versions 1.0 - 3.0).
+//
+// The shape of the array maps onto the extents of the HyperBuffer (C-order, i.e. the last dimension is the innermost
+// one). Reading does not copy the payload: it is used in place, either inside a memory blob (HyperBufferView) or
+// memory-mapped from a file (HyperBufferMapped). Writing streams the data straight from the buffer's data array.
+//
+// Supported data types: bool, signed & unsigned integers and floating-point numbers, in native byte order.
+// Fortran-order arrays and arrays of other byte order are rejected, since they cannot be used in place.
+// ---------------------------------------------------------------------------------------------------------------------
+namespace Npy
+{
+namespace detail
+{
+static constexpr char Magic[6] { '\x93', 'N', 'U', 'M', 'P', 'Y' };
+
+/** Data of the payload is aligned to this number of bytes relative to the start of the file (as written by NumPy) */
+static constexpr std::size_t HeaderAlignment = 64;
+
+inline bool isLittleEndian() noexcept
+{
+    const std::uint16_t value = 1;
+    unsigned char firstByte;
+    std::memcpy(&firstByte, &value, 1);
+    return firstByte == 1;
+}
+
+/** @returns the NumPy type descriptor of T, e.g. "<f4" */
+template<typename T>
+std::string getTypeDescriptor()
+{
+    using U = std::remove_cv_t<T>;
+    static_assert(std::is_arithmetic<U>::value, "Only arithmetic data types are supported");
+    const char kind = std::is_same<U, bool>::value ? 'b' : (std::is_floating_point<U>::value ? 'f' : (std::is_signed<U>::value ? 'i' : 'u'));
+    const char byteOrder = (sizeof(U) == 1) ? '|' : (isLittleEndian() ? '<' : '>');
+    return std::string { byteOrder, kind } + std::to_string(sizeof(U));
+}
+
+/** @returns true if a (parsed) type descriptor describes T in native byte order */
+template<typename T>
+bool isTypeDescriptorOf(const std::string& descriptor)
+{
+    const std::string expected = getTypeDescriptor<T>();
+    if (descriptor.size() != expected.size()) {
+        return false;
+    }
+    const char byteOrder = descriptor[0];
+    const bool nativeOrder = (byteOrder == expected[0]) || byteOrder == '=' || (sizeof(T) == 1 && byteOrder == '|');
+    return nativeOrder && descriptor.compare(1, std::string::npos, expected, 1, std::string::npos) == 0;
+}
+
+/** @returns the value of the given key in the header dictionary (up to the next ',' or the closing bracket/quote) */
+inline std::string findValue(const std::string& header, const std::string& key)
+{
+    std::size_t position = header.find("'" + key + "'");
+    if (position == std::string::npos) {
+        position = header.find("\"" + key + "\"");
+    }
+    ASSERT(position != std::string::npos, "Invalid .npy header");
+    position = header.find(':', position);
+    ASSERT(position != std::string::npos, "Invalid .npy header");
+    position = header.find_first_not_of(' ', position + 1);
+    ASSERT(position != std::string::npos, "Invalid .npy header");
+
+    const char opening = header[position];
+    if (opening == '(' || opening == '\'' || opening == '"') {
+        const char closing = (opening == '(') ? ')' : opening;
+        const std::size_t end = header.find(closing, position + 1);
+        ASSERT(end != std::string::npos, "Invalid .npy header");
+        return header.substr(position + 1, end - position - 1);
+    }
+    const std::size_t end = header.find_first_of(",}", position);
+    ASSERT(end != std::string::npos, "Invalid .npy header");
+    return header.substr(position, end - position);
+}
+
+/** Parses the header dictionary; @returns the shape of the array */
+template<typename T, int N>
+std::array<int, N> parseHeaderDictionary(const std::string& header)
+{
+    ASSERT(isTypeDescriptorOf<T>(findValue(header, "descr")), "Data type does not match");
+    ASSERT(findValue(header, "fortran_order").compare(0, 5, "False") == 0, "Fortran-order arrays are not supported");
+
+    const std::string shapeString = findValue(header, "shape");
+    std::array<int, N> shape;
+    int numDimensions = 0;
+    std::size_t position = 0;
+    while ((position = shapeString.find_first_of("0123456789", position)) != std::string::npos) {
+        const std::size_t end = shapeString.find_first_not_of("0123456789", position);
+        const std::string extent = shapeString.substr(position, end - position);
+        ASSERT(numDimensions < N, "Number of dimensions does not match");
+        ASSERT(extent.size() < 10 && std::stol(extent) > 0, "Invalid Dimension extents");
+        shape[numDimensions++] = std::stoi(extent);
+        position = end;
+    }
+    ASSERT(numDimensions == N, "Number of dimensions does not match");
+    return shape;
+}
+
+/** @returns the number of bytes of the preamble (magic, version, header length) and the header length */
+inline std::array<std::size_t, 2> parsePreamble(const unsigned char* bytes, std::size_t size)
+{
+    ASSERT(size >= 10 && std::memcmp(bytes, Magic, sizeof(Magic)) == 0, "Not a .npy file");
+    const unsigned char majorVersion = bytes[6];
+    ASSERT(majorVersion >= 1 && majorVersion <= 3, "Unsupported .npy version");
+    if (majorVersion == 1) {
+        return {{ 10, static_cast<std::size_t>(bytes[8] | (bytes[9] << 8)) }};
+    }
+    ASSERT(size >= 12, "Not a .npy file");
+    const std::size_t headerLength = static_cast<std::size_t>(bytes[8]) | (static_cast<std::size_t>(bytes[9]) << 8) |
+                                     (static_cast<std::size_t>(bytes[10]) << 16) | (static_cast<std::size_t>(bytes[11]) << 24);
+    return {{ 12, headerLength }};
+}
+
+/** Writes the rows of the lowest-order dimension one by one */
+template<typename T>
+void writeRows(std::ostream& stream, std::integral_constant<int, 1>, const int* extents, const T* row)
+{
+    stream.write(reinterpret_cast<const char*>(row), static_cast<std::streamsize>(extents[0] * sizeof(T)));
+}
+
+template<int D, typename Pointer>
+void writeRows(std::ostream& stream, std::integral_constant<int, D>, const int* extents, Pointer pointers)
+{
+    for (int i = 0; i < extents[0]; ++i) {
+        writeRows(stream, std::integral_constant<int, D-1>{}, extents + 1, pointers[i]);
+    }
+}
+} // namespace detail
+
+/** Writes the buffer in the .npy format (version 1.0) to a stream */
+template<typename T, int N, class StoragePolicy>
+void write(const HyperBuffer<T, N, StoragePolicy>& buffer, std::ostream& stream)
+{
+    std::string shape;
+    for (int extent : buffer.sizes()) {
+        shape += std::to_string(extent) + ", ";
+    }
+    shape.erase(shape.size() - ((N > 1) ? 2 : 1)); // a trailing comma is required for 1-tuples only
+    std::string header = "{'descr': '" + detail::getTypeDescriptor<T>() + "', 'fortran_order': False, 'shape': (" + shape + "), }";
+
+    // pad with spaces and terminate with a newline, such that the payload is aligned
+    const std::size_t unpaddedSize = 10 + header.size() + 1;
+    header.append((detail::HeaderAlignment - unpaddedSize % detail::HeaderAlignment) % detail::HeaderAlignment, ' ');
+    header += '\n';
+    ASSERT(header.size() <= 0xFFFF, "Header is too long");
+
+    const char preamble[10] { detail::Magic[0], detail::Magic[1], detail::Magic[2], detail::Magic[3], detail::Magic[4],
+                              detail::Magic[5], 1, 0, static_cast<char>(header.size() & 0xFF), static_cast<char>(header.size() >> 8) };
+    stream.write(preamble, sizeof(preamble));
+    stream.write(header.data(), static_cast<std::streamsize>(header.size()));
+
+    if (BufferOperations::detail::isFlat(buffer)) {
+        const T* data = BufferOperations::detail::firstElement(buffer.data());
+        const offset_type numElements = BufferOperations::detail::numElements(buffer.sizes());
+        const std::streamsize numBytes = numElements * static_cast<offset_type>(sizeof(T));
+        stream.write(reinterpret_cast<const char*>(data), numBytes);
+    } else {
+        detail::writeRows(stream, std::integral_constant<int, N>{}, buffer.sizes().data(), buffer.data());
+    }
+    ASSERT(stream.good(), "Cannot write .npy data");
+}
+
+/** Writes the buffer to a .npy file */
+template<typename T, int N, class StoragePolicy>
+void writeFile(const HyperBuffer<T, N, StoragePolicy>& buffer, const std::string& path)
+{
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    ASSERT(file.good(), "Cannot open file");
+    write(buffer, file);
+}
+
+/**
+ * Creates a view to the payload of a .npy file in memory: the data is used in place (no copy). The blob has to
+ * outlive the view and has to be aligned to at least the alignment of T. T can be const (for a const blob).
+ */
+template<typename T, int N>
+HyperBufferView<T, N> parse(std::conditional_t<std::is_const<T>::value, const void*, void*> blob, std::size_t blobSize)
+{
+    using Byte = std::conditional_t<std::is_const<T>::value, const unsigned char, unsigned char>;
+    Byte* bytes = static_cast<Byte*>(blob);
+    const std::array<std::size_t, 2> preamble = detail::parsePreamble(bytes, blobSize);
+    const std::size_t dataOffset = preamble[0] + preamble[1];
+    ASSERT(blobSize >= dataOffset, "Blob is too short");
+
+    const std::string header(reinterpret_cast<const char*>(bytes) + preamble[0], preamble[1]);
+    const BufferGeometry<N> geometry(detail::parseHeaderDictionary<T, N>(header));
+    ASSERT(blobSize - dataOffset >= static_cast<std::size_t>(geometry.getRequiredDataArraySize()) * sizeof(T), "Blob is too short");
+
+    T* data = reinterpret_cast<T*>(bytes + dataOffset);
+    ASSERT(reinterpret_cast<std::uintptr_t>(data) % alignof(T) == 0, "Data is misaligned");
+    return HyperBufferView<T, N>(data, geometry);
+}
+
+/**
+ * Memory-maps the payload of a .npy file: the data is used in place, and paged in lazily.
+ * The default mode is ReadOnly for a const T, CopyOnWrite otherwise (@see MappedFile::Mode).
+ */
+template<typename T, int N>
+HyperBufferMapped<T, N> readFile(const std::string& path,
+                                 MappedFile::Mode mode = std::is_const<T>::value ? MappedFile::Mode::ReadOnly
+                                                                                 : MappedFile::Mode::CopyOnWrite)
+{
+    std::ifstream file(path, std::ios::binary);
+    std::array<unsigned char, 12> preambleBytes {};
+    file.read(reinterpret_cast<char*>(preambleBytes.data()), static_cast<std::streamsize>(preambleBytes.size()));
+    ASSERT(file.gcount() >= 10, "Cannot read file");
+    const std::array<std::size_t, 2> preamble = detail::parsePreamble(preambleBytes.data(), static_cast<std::size_t>(file.gcount()));
+
+    std::string header(preamble[1], ' ');
+    file.clear();
+    file.seekg(static_cast<std::streamoff>(preamble[0]));
+    file.read(&header[0], static_cast<std::streamsize>(header.size()));
+    ASSERT(file.good(), "Cannot read file");
+
+    MappedFile::Options options;
+    options.mode = mode;
+    options.offset = preamble[0] + preamble[1];
+    return HyperBufferMapped<T, N>(path, options, detail::parseHeaderDictionary<T, N>(header));
+}
+
+} // namespace Npy
+} // namespace slb
@@ -0,0 +1,399 @@
+//
+//  ╦ ╦┬ ┬┌─┐┌─┐┬─┐  ╔╗ ┬ ┬┌─┐┌─┐┌─┐┬─┐
+//  ╠═╣└┬┘├─┘├┤ ├┬┘  ╠╩╗│ │├┤ ├┤ ├┤ ├┬┘
+//  ╩ ╩ ┴ ┴  └─┘┴└─  ╚═╝└─┘└  └  └─┘┴└─
+//
+//  © 2023 Lorenz Bucher - all rights reserved
+//  https://github.com/Sidelobe/HyperBuffer
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <type_traits>
+#include <utility>
+
+#include "HyperBuffer.hpp"
+#include "ThreadPool.hpp"
+
+namespace slb
+{
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Reductions of a buffer's elements: sum, minimum, maximum, mean, RMS and peak (largest absolute value).
+//
+// - over the entire buffer, e.g. `Reductions::peak(buffer)`, optionally in parallel on a ThreadPool
+// - along one axis, into a buffer with one dimension less, e.g. the peak of every channel of a [channel][sample]
+//   buffer: `Reductions::peak(buffer, 1)`. The result is either returned, or written to a given buffer (any storage
+//   policy) without allocation: `Reductions::peak(meters, buffer, 1)`
+//
+// float and double are reduced with SIMD, using several accumulators. Sums are computed by pairwise summation along
+// the rows (the innermost dimension), and accumulated element-wise along all other axes.
+// Minimum, maximum and peak are NaN if any of the reduced elements is NaN.
+// ---------------------------------------------------------------------------------------------------------------------
+namespace Reductions
+{
+namespace detail
+{
+using BufferOperations::detail::firstElement;
+using BufferOperations::detail::forEachRow;
+using BufferOperations::detail::isFlat;
+using BufferOperations::detail::numElements;
+
+/**
+ * Reduction of a row to a value (reduce), of two partial results (combine), and element-wise reduction of rows along
+ * an axis: the first row initializes the result, all others are accumulated.
+ */
+struct Sum
+{
+    template<typename T> static T reduce(const T* row, offset_type n) noexcept { return SimdKernels::sum(row, n); }
+    template<typename T> static T combine(T a, T b) noexcept { return a + b; }
+    template<typename T> static void initialize(T* dst, const T* src, offset_type n) noexcept { SimdKernels::copy(dst, src, n); }
+    template<typename T> static void accumulate(T* dst, const T* src, offset_type n) noexcept { SimdKernels::add(dst, src, n); }
+};
+
+struct SumOfSquares
+{
+    template<typename T> static T reduce(const T* row, offset_type n) noexcept { return SimdKernels::sumOfSquares(row, n); }
+    template<typename T> static T combine(T a, T b) noexcept { return a + b; }
+    template<typename T> static void initialize(T* dst, const T* src, offset_type n) noexcept
+    {
+        SimdKernels::fill(dst, T(0), n);
+        SimdKernels::multiplyAccumulate(dst, src, src, n);
+    }
+    template<typename T> static void accumulate(T* dst, const T* src, offset_type n) noexcept { SimdKernels::multiplyAccumulate(dst, src, src, n); }
+};
+
+struct Minimum
+{
+    template<typename T> static T reduce(const T* row, offset_type n) noexcept { return SimdKernels::minimum(row, n); }
+    template<typename T> static T combine(T a, T b) noexcept { return SimdKernels::detail::min(a, b); }
+    template<typename T> static void initialize(T* dst, const T* src, offset_type n) noexcept { SimdKernels::copy(dst, src, n); }
+    template<typename T> static void accumulate(T* dst, const T* src, offset_type n) noexcept { SimdKernels::accumulateMin(dst, src, n); }
+};
+
+struct Maximum
+{
+    template<typename T> static T reduce(const T* row, offset_type n) noexcept { return SimdKernels::maximum(row, n); }
+    template<typename T> static T combine(T a, T b) noexcept { return SimdKernels::detail::max(a, b); }
+    template<typename T> static void initialize(T* dst, const T* src, offset_type n) noexcept { SimdKernels::copy(dst, src, n); }
+    template<typename T> static void accumulate(T* dst, const T* src, offset_type n) noexcept { SimdKernels::accumulateMax(dst, src, n); }
+};
+
+struct Peak
+{
+    template<typename T> static T reduce(const T* row, offset_type n) noexcept { return SimdKernels::peak(row, n); }
+    template<typename T> static T combine(T a, T b) noexcept { return SimdKernels::detail::max(a, b); }
+    template<typename T> static void initialize(T* dst, const T* src, offset_type n) noexcept
+    {
+        SimdKernels::fill(dst, T(0), n);
+        SimdKernels::accumulatePeak(dst, src, n);
+    }
+    template<typename T> static void accumulate(T* dst, const T* src, offset_type n) noexcept { SimdKernels::accumulatePeak(dst, src, n); }
+};
+
+// MARK: entire buffer
+
+template<class Reduction, typename T, int N, class StoragePolicy>
+T reduceAll(const HyperBuffer<T, N, StoragePolicy>& buffer)
+{
+    if (N == 1 || isFlat(buffer)) {
+        return Reduction::reduce(firstElement(buffer.data()), numElements(buffer.sizes()));
+    }
+    T result {};
+    bool isFirstRow = true;
+    auto rowOp = [&result, &isFirstRow](offset_type n, const T* row) {
+        const T rowResult = Reduction::reduce(row, n);
+        result = isFirstRow ? rowResult : Reduction::combine(result, rowResult);
+        isFirstRow = false;
+    };
+    forEachRow(std::integral_constant<int, N>{}, buffer.sizes().data(), rowOp, buffer.data());
+    return result;
+}
+
+/** Maximum number of partial results of a parallel reduction (kept on the stack) */
+static constexpr int MaxNumPartialResults = 256;
+
+template<class Reduction, typename T, int N, class StoragePolicy>
+void reducePartitions(const HyperBuffer<T, N, StoragePolicy>& buffer, ThreadPool& pool, T* partialResults, int& numPartitions,
+                      std::false_type /*split the outermost dimension*/)
+{
+    const T* data = firstElement(buffer.data());
+    const offset_type numTotal = numElements(buffer.sizes());
+    numPartitions = static_cast<int>(std::min<offset_type>(std::min(pool.getNumThreads(), MaxNumPartialResults), numTotal));
+    const int numParts = numPartitions;
+    pool.parallelFor(numParts, [=](int part) {
+        const offset_type begin = numTotal * part / numParts;
+        const offset_type end = numTotal * (part + 1) / numParts;
+        partialResults[part] = Reduction::reduce(data + begin, end - begin);
+    });
+}
+
+template<class Reduction, typename T, int N, class StoragePolicy>
+void reducePartitions(const HyperBuffer<T, N, StoragePolicy>& buffer, ThreadPool& pool, T* partialResults, int& numPartitions,
+                      std::true_type /*split the outermost dimension*/)
+{
+    if (isFlat(buffer)) {
+        reducePartitions<Reduction>(buffer, pool, partialResults, numPartitions, std::false_type{});
+        return;
+    }
+    const int numOuter = buffer.size(0);
+    numPartitions = std::min({ pool.getNumThreads(), MaxNumPartialResults, numOuter });
+    const int numParts = numPartitions;
+    pool.parallelFor(numParts, [=, &buffer](int part) {
+        const int begin = static_cast<int>(static_cast<offset_type>(numOuter) * part / numParts);
+        const int end = static_cast<int>(static_cast<offset_type>(numOuter) * (part + 1) / numParts);
+        T result = reduceAll<Reduction>(buffer.subView(begin));
+        for (int i = begin + 1; i < end; ++i) {
+            result = Reduction::combine(result, reduceAll<Reduction>(buffer.subView(i)));
+        }
+        partialResults[part] = result;
+    });
+}
+
+/** Reduces partitions of the buffer on the pool's threads, then combines the partial results */
+template<class Reduction, typename T, int N, class StoragePolicy>
+T reduceAll(const HyperBuffer<T, N, StoragePolicy>& buffer, ThreadPool& pool)
+{
+    std::array<T, MaxNumPartialResults> partialResults;
+    int numPartitions = 0;
+    reducePartitions<Reduction>(buffer, pool, partialResults.data(), numPartitions, std::integral_constant<bool, (N > 1)>{});
+    T result = partialResults[0];
+    for (int part = 1; part < numPartitions; ++part) {
+        result = Reduction::combine(result, partialResults[static_cast<std::size_t>(part)]);
+    }
+    return result;
+}
+
+// MARK: along an axis
+
+/** @returns the pointer structure of the result for the element/sub-dimension at the given index */
+template<typename T>
+T* subResult(std::integral_constant<int, 2>, T* result, int index) noexcept { return result + index; }
+
+template<int D, typename Pointer>
+auto subResult(std::integral_constant<int, D>, Pointer result, int index) noexcept { return result[index]; }
+
+/** Reduces the D-dimensional `src` along `axis` into `dst`, which has D-1 dimensions (or points to a single element) */
+template<class Reduction, typename T>
+void reduceAlong(std::integral_constant<int, 1>, const int* extents, int /*axis*/, const T* src, T* dst)
+{
+    *dst = Reduction::reduce(src, extents[0]);
+}
+
+template<class Reduction, int D, typename SrcPointer, typename DstPointer>
+void reduceAlong(std::integral_constant<int, D>, const int* extents, int axis, SrcPointer src, DstPointer dst)
+{
+    if (axis > 0) {
+        for (int i = 0; i < extents[0]; ++i) {
+            reduceAlong<Reduction>(std::integral_constant<int, D-1>{}, extents + 1, axis - 1, src[i],
+                                   subResult(std::integral_constant<int, D>{}, dst, i));
+        }
+        return;
+    }
+    // reduce the sub-dimensions at all indices of this dimension element-wise
+    auto initialize = [](offset_type n, auto* d, const auto* s) { Reduction::initialize(d, s, n); };
+    auto accumulate = [](offset_type n, auto* d, const auto* s) { Reduction::accumulate(d, s, n); };
+    forEachRow(std::integral_constant<int, D-1>{}, extents + 1, initialize, dst, src[0]);
+    for (int i = 1; i < extents[0]; ++i) {
+        forEachRow(std::integral_constant<int, D-1>{}, extents + 1, accumulate, dst, src[i]);
+    }
+}
+
+template<class Reduction, typename T, int N, class StoragePolicy, class ResultStoragePolicy>
+void reduceAlong(HyperBuffer<T, N-1, ResultStoragePolicy>& result, const HyperBuffer<T, N, StoragePolicy>& buffer, int axis)
+{
+    static_assert(N > 1, "Use the reduction of the entire buffer for 1 dimension");
+    ASSERT(axis >= 0 && axis < N, "Invalid axis");
+    for (int dim = 0; dim < N-1; ++dim) {
+        ASSERT(result.size(dim) == buffer.size(dim < axis ? dim : dim + 1), "Extents of the result do not match");
+    }
+    reduceAlong<Reduction>(std::integral_constant<int, N>{}, buffer.sizes().data(), axis, buffer.data(), result.data());
+}
+
+/** @returns a new buffer with the extents of the given buffer, except for the removed axis */
+template<typename T, int N, std::size_t... I>
+HyperBuffer<T, N-1> createResult(const std::array<int, N>& extents, int axis, std::index_sequence<I...>)
+{
+    return HyperBuffer<T, N-1>(extents[I < static_cast<std::size_t>(axis) ? I : I + 1]...);
+}
+
+template<typename T, int N>
+HyperBuffer<T, N-1> createResult(const std::array<int, N>& extents, int axis)
+{
+    ASSERT(axis >= 0 && axis < N, "Invalid axis");
+    return createResult<T, N>(extents, axis, std::make_index_sequence<N-1>{});
+}
+
+/** result = sqrt(result) (element-wise) */
+template<typename T, int N, class StoragePolicy>
+void squareRoot(HyperBuffer<T, N, StoragePolicy>& result)
+{
+    auto rowOp = [](offset_type n, T* row) {
+        for (offset_type i = 0; i < n; ++i) {
+            row[i] = std::sqrt(row[i]);
+        }
+    };
+    forEachRow(std::integral_constant<int, N>{}, result.sizes().data(), rowOp, result.data());
+}
+} // namespace detail
+
+// MARK: - Entire buffer
+
+/** @returns the sum of all elements */
+template<typename T, int N, class StoragePolicy>
+T sum(const HyperBuffer<T, N, StoragePolicy>& buffer) { return detail::reduceAll<detail::Sum>(buffer); }
+
+/** @returns the smallest element */
+template<typename T, int N, class StoragePolicy>
+T minimum(const HyperBuffer<T, N, StoragePolicy>& buffer) { return detail::reduceAll<detail::Minimum>(buffer); }
+
+/** @returns the largest element */
+template<typename T, int N, class StoragePolicy>
+T maximum(const HyperBuffer<T, N, StoragePolicy>& buffer) { return detail::reduceAll<detail::Maximum>(buffer); }
+
+/** @returns the largest absolute value */
+template<typename T, int N, class StoragePolicy>
+T peak(const HyperBuffer<T, N, StoragePolicy>& buffer) { return detail::reduceAll<detail::Peak>(buffer); }
+
+/** @returns the arithmetic mean of all elements */
+template<typename T, int N, class StoragePolicy>
+T mean(const HyperBuffer<T, N, StoragePolicy>& buffer)
+{
+    static_assert(std::is_floating_point<T>::value, "Requires a floating-point data type");
+    return sum(buffer) / static_cast<T>(detail::numElements(buffer.sizes()));
+}
+
+/** @returns the root mean square of all elements */
+template<typename T, int N, class StoragePolicy>
+T rms(const HyperBuffer<T, N, StoragePolicy>& buffer)
+{
+    static_assert(std::is_floating_point<T>::value, "Requires a floating-point data type");
+    return std::sqrt(detail::reduceAll<detail::SumOfSquares>(buffer) / static_cast<T>(detail::numElements(buffer.sizes())));
+}
+
+// MARK: - Entire buffer, in parallel (for large buffers: partitions are reduced on the threads of the pool)
+
+template<typename T, int N, class StoragePolicy>
+T sum(const HyperBuffer<T, N, StoragePolicy>& buffer, ThreadPool& pool) { return detail::reduceAll<detail::Sum>(buffer, pool); }
+
+template<typename T, int N, class StoragePolicy>
+T minimum(const HyperBuffer<T, N, StoragePolicy>& buffer, ThreadPool& pool) { return detail::reduceAll<detail::Minimum>(buffer, pool); }
+
+template<typename T, int N, class StoragePolicy>
+T maximum(const HyperBuffer<T, N, StoragePolicy>& buffer, ThreadPool& pool) { return detail::reduceAll<detail::Maximum>(buffer, pool); }
+
+template<typename T, int N, class StoragePolicy>
+T peak(const HyperBuffer<T, N, StoragePolicy>& buffer, ThreadPool& pool) { return detail::reduceAll<detail::Peak>(buffer, pool); }
+
+template<typename T, int N, class StoragePolicy>
+T mean(const HyperBuffer<T, N, StoragePolicy>& buffer, ThreadPool& pool)
+{
+    static_assert(std::is_floating_point<T>::value, "Requires a floating-point data type");
+    return sum(buffer, pool) / static_cast<T>(detail::numElements(buffer.sizes()));
+}
+
+template<typename T, int N, class StoragePolicy>
+T rms(const HyperBuffer<T, N, StoragePolicy>& buffer, ThreadPool& pool)
+{
+    static_assert(std::is_floating_point<T>::value, "Requires a floating-point data type");
+    return std::sqrt(detail::reduceAll<detail::SumOfSquares>(buffer, pool) / static_cast<T>(detail::numElements(buffer.sizes())));
+}
+
+// MARK: - Along an axis, into a given result (no allocation)
+
+/** result = sum along the axis; the result has the extents of the buffer without the axis */
+template<typename T, int N, class StoragePolicy, class ResultStoragePolicy>
+void sum(HyperBuffer<T, N-1, ResultStoragePolicy>& result, const HyperBuffer<T, N, StoragePolicy>& buffer, int axis)
+{
+    detail::reduceAlong<detail::Sum>(result, buffer, axis);
+}
+
+template<typename T, int N, class StoragePolicy, class ResultStoragePolicy>
+void minimum(HyperBuffer<T, N-1, ResultStoragePolicy>& result, const HyperBuffer<T, N, StoragePolicy>& buffer, int axis)
+{
+    detail::reduceAlong<detail::Minimum>(result, buffer, axis);
+}
+
+template<typename T, int N, class StoragePolicy, class ResultStoragePolicy>
+void maximum(HyperBuffer<T, N-1, ResultStoragePolicy>& result, const HyperBuffer<T, N, StoragePolicy>& buffer, int axis)
+{
+    detail::reduceAlong<detail::Maximum>(result, buffer, axis);
+}
+
+template<typename T, int N, class StoragePolicy, class ResultStoragePolicy>
+void peak(HyperBuffer<T, N-1, ResultStoragePolicy>& result, const HyperBuffer<T, N, StoragePolicy>& buffer, int axis)
+{
+    detail::reduceAlong<detail::Peak>(result, buffer, axis);
+}
+
+template<typename T, int N, class StoragePolicy, class ResultStoragePolicy>
+void mean(HyperBuffer<T, N-1, ResultStoragePolicy>& result, const HyperBuffer<T, N, StoragePolicy>& buffer, int axis)
+{
+    static_assert(std::is_floating_point<T>::value, "Requires a floating-point data type");
+    detail::reduceAlong<detail::Sum>(result, buffer, axis);
+    BufferOperations::scale(result, T(1) / static_cast<T>(buffer.size(axis)));
+}
+
+template<typename T, int N, class StoragePolicy, class ResultStoragePolicy>
+void rms(HyperBuffer<T, N-1, ResultStoragePolicy>& result, const HyperBuffer<T, N, StoragePolicy>& buffer, int axis)
+{
+    static_assert(std::is_floating_point<T>::value, "Requires a floating-point data type");
+    detail::reduceAlong<detail::SumOfSquares>(result, buffer, axis);
+    BufferOperations::scale(result, T(1) / static_cast<T>(buffer.size(axis)));
+    detail::squareRoot(result);
+}
+
+// MARK: - Along an axis, returning a new buffer
+
+template<typename T, int N, class StoragePolicy>
+HyperBuffer<T, N-1> sum(const HyperBuffer<T, N, StoragePolicy>& buffer, int axis)
+{
+    auto result = detail::createResult<T, N>(buffer.sizes(), axis);
+    sum(result, buffer, axis);
+    return result;
+}
+
+template<typename T, int N, class StoragePolicy>
+HyperBuffer<T, N-1> minimum(const HyperBuffer<T, N, StoragePolicy>& buffer, int axis)
+{
+    auto result = detail::createResult<T, N>(buffer.sizes(), axis);
+    minimum(result, buffer, axis);
+    return result;
+}
+
+template<typename T, int N, class StoragePolicy>
+HyperBuffer<T, N-1> maximum(const HyperBuffer<T, N, StoragePolicy>& buffer, int axis)
+{
+    auto result = detail::createResult<T, N>(buffer.sizes(), axis);
+    maximum(result, buffer, axis);
+    return result;
+}
+
+template<typename T, int N, class StoragePolicy>
+HyperBuffer<T, N-1> peak(const HyperBuffer<T, N, StoragePolicy>& buffer, int axis)
+{
+    auto result = detail::createResult<T, N>(buffer.sizes(), axis);
+    peak(result, buffer, axis);
+    return result;
+}
+
+template<typename T, int N, class StoragePolicy>
+HyperBuffer<T, N-1> mean(const HyperBuffer<T, N, StoragePolicy>& buffer, int axis)
+{
+    auto result = detail::createResult<T, N>(buffer.sizes(), axis);
+    mean(result, buffer, axis);
+    return result;
+}
+
+template<typename T, int N, class StoragePolicy>
+HyperBuffer<T, N-1> rms(const HyperBuffer<T, N, StoragePolicy>& buffer, int axis)
+{
+    auto result = detail::createResult<T, N>(buffer.sizes(), axis);
+    rms(result, buffer, axis);
+    return result;
+}
+
+} // namespace Reductions
+} // namespace slb
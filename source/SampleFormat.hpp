@@ -0,0 +1,321 @@
+//
+//  ╦ ╦┬ ┬┌─┐┌─┐┬─┐  ╔╗ ┬ ┬┌─┐┌─┐┌─┐┬─┐
+//  ╠═╣└┬┘├─┘├┤ ├┬┘  ╠╩╗│ │├┤ ├┤ ├┤ ├┬┘
+//  ╩ ╩ ┴ ┴  └─┘┴└─  ╚═╝└─┘└  └  └─┘┴└─
+//
+//  © 2023 Lorenz Bucher - all rights reserved
+//  https://github.com/Sidelobe/HyperBuffer
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+#include "HyperBuffer.hpp"
+#include "SimdKernels.hpp"
+
+namespace slb
+{
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Conversion between integer PCM samples (16, 24 and 32 bit) and float samples in the range [-1, 1).
+//
+// Integer samples are scaled by 2^-(bits-1), e.g. 16-bit: -32768 -> -1.f, 16384 -> 0.5f. Converting back, float
+// samples are scaled by 2^(bits-1), optionally dithered, rounded to the nearest integer and saturated to the range of
+// the integer format (out-of-range samples are clipped, NaN becomes the minimum value).
+//
+// 16-bit and 32-bit conversions are vectorized (SSE / NEON on AArch64), 24-bit samples (packed, 3 bytes) are processed
+// by the scalar loop. The vectorized and the scalar results are identical.
+// ---------------------------------------------------------------------------------------------------------------------
+namespace SampleFormat
+{
+/** Packed 24-bit sample: 3 bytes, little endian */
+struct Int24
+{
+    unsigned char bytes[3];
+};
+static_assert(sizeof(Int24) == 3, "Int24 must not be padded");
+
+/** Properties and access of the supported integer formats */
+template<typename Format> struct Traits;
+
+template<>
+struct Traits<std::int16_t>
+{
+    static constexpr float FullScale = 32768.f;
+    static constexpr float Min = -32768.f;
+    static constexpr float Max = 32767.f;
+    static std::int32_t read(std::int16_t sample) noexcept { return sample; }
+    static void write(std::int16_t& sample, std::int32_t value) noexcept { sample = static_cast<std::int16_t>(value); }
+};
+
+template<>
+struct Traits<Int24>
+{
+    static constexpr float FullScale = 8388608.f;
+    static constexpr float Min = -8388608.f;
+    static constexpr float Max = 8388607.f;
+    static std::int32_t read(Int24 sample) noexcept
+    {
+        const std::uint32_t value = sample.bytes[0] | (sample.bytes[1] << 8u) | (static_cast<std::uint32_t>(sample.bytes[2]) << 16u);
+        return static_cast<std::int32_t>(value ^ 0x800000u) - 0x800000; // sign extension
+    }
+    static void write(Int24& sample, std::int32_t value) noexcept
+    {
+        const std::uint32_t bits = static_cast<std::uint32_t>(value);
+        sample.bytes[0] = static_cast<unsigned char>(bits & 0xFF);
+        sample.bytes[1] = static_cast<unsigned char>((bits >> 8) & 0xFF);
+        sample.bytes[2] = static_cast<unsigned char>((bits >> 16) & 0xFF);
+    }
+};
+
+template<>
+struct Traits<std::int32_t>
+{
+    static constexpr float FullScale = 2147483648.f;
+    static constexpr float Min = -2147483648.f;
+    static constexpr float Max = 2147483520.f; // largest float below 2^31
+    static std::int32_t read(std::int32_t sample) noexcept { return sample; }
+    static void write(std::int32_t& sample, std::int32_t value) noexcept { sample = value; }
+};
+
+/**
+ * Triangular (TPDF) dither with an amplitude of +/- 1 LSB, added before rounding to decorrelate the quantization error
+ * from the signal. The state of the random number generator carries over from one block to the next.
+ */
+class TriangularDither
+{
+public:
+    explicit TriangularDither(std::uint32_t seed = 1) noexcept : m_state(seed != 0 ? seed : 1) {}
+
+    /** @returns the next random value in (-1, 1), with a triangular distribution */
+    float next() noexcept { return uniform() - uniform(); }
+
+private:
+    /** @returns a random value in [0, 1) (xorshift32) */
+    float uniform() noexcept
+    {
+        m_state ^= m_state << 13;
+        m_state ^= m_state >> 17;
+        m_state ^= m_state << 5;
+        return static_cast<float>(m_state >> 8) * (1.f / 16777216.f);
+    }
+
+    std::uint32_t m_state;
+};
+
+namespace detail
+{
+/** Saturates to [low, high]; NaN becomes `low` (same behaviour as the SIMD min/max instructions) */
+inline float saturate(float value, float low, float high) noexcept
+{
+    return (value >= low) ? ((value <= high) ? value : high) : low;
+}
+
+/** Vectorized conversion of as many samples as possible; @returns the number of samples converted */
+template<typename Format>
+inline offset_type toFloatVectorized(float*, const Format*, offset_type) noexcept { return 0; }
+
+template<typename Format>
+inline offset_type fromFloatVectorized(Format*, const float*, offset_type, TriangularDither*) noexcept { return 0; }
+
+#if defined(SLB_SIMD_AVX512) || defined(SLB_SIMD_AVX) || defined(SLB_SIMD_SSE) || \
+    (defined(SLB_SIMD_NEON) && (defined(__aarch64__) || defined(_M_ARM64)))
+  #define SLB_SIMD_SAMPLE_FORMAT
+
+#if defined(SLB_SIMD_NEON)
+struct SimdSamples
+{
+    using Register = float32x4_t;
+    static Register load(const float* p) noexcept { return vld1q_f32(p); }
+    static void store(float* p, Register r) noexcept { vst1q_f32(p, r); }
+    static Register broadcast(float v) noexcept { return vdupq_n_f32(v); }
+    static Register add(Register a, Register b) noexcept { return vaddq_f32(a, b); }
+    static Register mul(Register a, Register b) noexcept { return vmulq_f32(a, b); }
+    static Register saturate(Register v, Register low, Register high) noexcept { return vminq_f32(vmaxnmq_f32(v, low), high); } // NaN -> low
+
+    static Register load(const std::int16_t* p) noexcept { return vcvtq_f32_s32(vmovl_s16(vld1_s16(p))); }
+    static Register load(const std::int32_t* p) noexcept { return vcvtq_f32_s32(vld1q_s32(p)); }
+    static void store(std::int16_t* p, Register r) noexcept { vst1_s16(p, vqmovn_s32(vcvtnq_s32_f32(r))); }
+    static void store(std::int32_t* p, Register r) noexcept { vst1q_s32(p, vcvtnq_s32_f32(r)); }
+};
+#else
+struct SimdSamples
+{
+    using Register = __m128;
+    static Register load(const float* p) noexcept { return _mm_loadu_ps(p); }
+    static void store(float* p, Register r) noexcept { _mm_storeu_ps(p, r); }
+    static Register broadcast(float v) noexcept { return _mm_set1_ps(v); }
+    static Register add(Register a, Register b) noexcept { return _mm_add_ps(a, b); }
+    static Register mul(Register a, Register b) noexcept { return _mm_mul_ps(a, b); }
+    static Register saturate(Register v, Register low, Register high) noexcept { return _mm_min_ps(_mm_max_ps(v, low), high); }
+
+    static Register load(const std::int16_t* p) noexcept
+    {
+        const __m128i samples = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(p));
+        return _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(samples, samples), 16)); // sign extension
+    }
+    static Register load(const std::int32_t* p) noexcept { return _mm_cvtepi32_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p))); }
+
+    // rounding to nearest (even): default rounding mode, identical to std::nearbyint()
+    static void store(std::int16_t* p, Register r) noexcept
+    {
+        const __m128i samples = _mm_cvtps_epi32(r);
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(p), _mm_packs_epi32(samples, samples));
+    }
+    static void store(std::int32_t* p, Register r) noexcept { _mm_storeu_si128(reinterpret_cast<__m128i*>(p), _mm_cvtps_epi32(r)); }
+};
+#endif
+
+template<typename Format>
+inline offset_type toFloatVectorized(float* dst, const Format* src, std::true_type /*vectorized format*/, offset_type n) noexcept
+{
+    using P = SimdSamples;
+    const P::Register scale = P::broadcast(1.f / Traits<Format>::FullScale);
+    offset_type i = 0;
+    for (; i + 4 <= n; i += 4) {
+        P::store(dst + i, P::mul(P::load(src + i), scale));
+    }
+    return i;
+}
+
+template<typename Format>
+inline offset_type fromFloatVectorized(Format* dst, const float* src, offset_type n, TriangularDither* dither, std::true_type) noexcept
+{
+    using P = SimdSamples;
+    const P::Register scale = P::broadcast(Traits<Format>::FullScale);
+    const P::Register low = P::broadcast(Traits<Format>::Min);
+    const P::Register high = P::broadcast(Traits<Format>::Max);
+    offset_type i = 0;
+    for (; i + 4 <= n; i += 4) {
+        P::Register value = P::mul(P::load(src + i), scale);
+        if (dither != nullptr) {
+            const float noise[4] { dither->next(), dither->next(), dither->next(), dither->next() }; // in order
+            value = P::add(value, P::load(noise));
+        }
+        P::store(dst + i, P::saturate(value, low, high));
+    }
+    return i;
+}
+
+inline offset_type toFloatVectorized(float* dst, const std::int16_t* src, offset_type n) noexcept { return toFloatVectorized(dst, src, std::true_type{}, n); }
+inline offset_type toFloatVectorized(float* dst, const std::int32_t* src, offset_type n) noexcept { return toFloatVectorized(dst, src, std::true_type{}, n); }
+
+inline offset_type fromFloatVectorized(std::int16_t* dst, const float* src, offset_type n, TriangularDither* dither) noexcept
+{
+    return fromFloatVectorized(dst, src, n, dither, std::true_type{});
+}
+inline offset_type fromFloatVectorized(std::int32_t* dst, const float* src, offset_type n, TriangularDither* dither) noexcept
+{
+    return fromFloatVectorized(dst, src, n, dither, std::true_type{});
+}
+#endif
+
+/** Number of samples that are converted at a time by the fused (de-)interleaving conversions (on the stack) */
+static constexpr int ChunkSize = 1024;
+} // namespace detail
+
+// MARK: - Flat arrays
+
+/** dst[i] = src[i] / 2^(bits-1) */
+template<typename Format>
+inline void toFloat(float* dst, const Format* src, offset_type n) noexcept
+{
+    constexpr float scale = 1.f / Traits<Format>::FullScale;
+    for (offset_type i = detail::toFloatVectorized(dst, src, n); i < n; ++i) {
+        dst[i] = static_cast<float>(Traits<Format>::read(src[i])) * scale;
+    }
+}
+
+/** dst[i] = round(src[i] * 2^(bits-1) + dither), saturated to the range of the format */
+template<typename Format>
+inline void fromFloat(Format* dst, const float* src, offset_type n, TriangularDither* dither = nullptr) noexcept
+{
+    for (offset_type i = detail::fromFloatVectorized(dst, src, n, dither); i < n; ++i) {
+        float value = src[i] * Traits<Format>::FullScale;
+        if (dither != nullptr) {
+            value += dither->next();
+        }
+        value = detail::saturate(value, Traits<Format>::Min, Traits<Format>::Max);
+        Traits<Format>::write(dst[i], static_cast<std::int32_t>(std::nearbyint(value)));
+    }
+}
+
+// MARK: - HyperBuffers
+
+/** Fills the buffer from integer samples, which are expected in the order of the buffer's elements (row by row) */
+template<typename Format, int N, class StoragePolicy>
+void toFloat(HyperBuffer<float, N, StoragePolicy>& dst, const Format* src)
+{
+    if (BufferOperations::detail::isFlat(dst)) {
+        toFloat(BufferOperations::detail::firstElement(dst.data()), src, BufferOperations::detail::numElements(dst.sizes()));
+        return;
+    }
+    auto rowOp = [&src](offset_type n, float* row) { toFloat(row, src, n); src += n; };
+    BufferOperations::detail::forEachRow(std::integral_constant<int, N>{}, dst.sizes().data(), rowOp, dst.data());
+}
+
+/** Writes the buffer's elements (row by row) as integer samples */
+template<typename Format, int N, class StoragePolicy>
+void fromFloat(Format* dst, const HyperBuffer<float, N, StoragePolicy>& src, TriangularDither* dither = nullptr)
+{
+    if (BufferOperations::detail::isFlat(src)) {
+        fromFloat(dst, BufferOperations::detail::firstElement(src.data()), BufferOperations::detail::numElements(src.sizes()), dither);
+        return;
+    }
+    auto rowOp = [&dst, dither](offset_type n, const float* row) { fromFloat(dst, row, n, dither); dst += n; };
+    BufferOperations::detail::forEachRow(std::integral_constant<int, N>{}, src.sizes().data(), rowOp, src.data());
+}
+
+/**
+ * Converts a stream of interleaved integer frames into the channels of a [channel][frame] buffer, which has to contain
+ * dst.size(1) frames of dst.size(0) channels. The frames are converted in chunks on the stack and deinterleaved
+ * while still in the cache (frames with more than detail::ChunkSize channels are split into several chunks).
+ */
+template<typename Format, class StoragePolicy>
+void deinterleaveToFloat(HyperBuffer<float, 2, StoragePolicy>& dst, const Format* interleaved)
+{
+    const int numChannels = dst.size(0);
+    const offset_type numFrames = dst.size(1);
+    const int channelsPerChunk = std::min(numChannels, detail::ChunkSize);
+    const offset_type framesPerChunk = std::max(1, detail::ChunkSize / numChannels);
+
+    float chunk[detail::ChunkSize];
+    for (offset_type frame = 0; frame < numFrames; frame += framesPerChunk) {
+        const offset_type numChunkFrames = std::min(framesPerChunk, numFrames - frame);
+        for (int channel = 0; channel < numChannels; channel += channelsPerChunk) {
+            // either all channels, or a single frame: the samples of a chunk are contiguous in the stream
+            const int numChunkChannels = std::min(channelsPerChunk, numChannels - channel);
+            toFloat(chunk, interleaved + frame * numChannels + channel, numChunkFrames * numChunkChannels);
+            SimdKernels::deinterleave(dst.data() + channel, chunk, numChunkChannels, numChunkFrames, frame);
+        }
+    }
+}
+
+/**
+ * Converts the channels of a [channel][frame] buffer into a stream of interleaved integer frames, which has to hold
+ * src.size(1) frames of src.size(0) channels. The frames are interleaved in chunks on the stack and converted while
+ * still in the cache (frames with more than detail::ChunkSize channels are split into several chunks).
+ */
+template<typename Format, class StoragePolicy>
+void interleaveFromFloat(Format* interleaved, const HyperBuffer<float, 2, StoragePolicy>& src, TriangularDither* dither = nullptr)
+{
+    const int numChannels = src.size(0);
+    const offset_type numFrames = src.size(1);
+    const int channelsPerChunk = std::min(numChannels, detail::ChunkSize);
+    const offset_type framesPerChunk = std::max(1, detail::ChunkSize / numChannels);
+
+    float chunk[detail::ChunkSize];
+    for (offset_type frame = 0; frame < numFrames; frame += framesPerChunk) {
+        const offset_type numChunkFrames = std::min(framesPerChunk, numFrames - frame);
+        for (int channel = 0; channel < numChannels; channel += channelsPerChunk) {
+            const int numChunkChannels = std::min(channelsPerChunk, numChannels - channel);
+            SimdKernels::interleave(chunk, src.data() + channel, numChunkChannels, numChunkFrames, frame);
+            fromFloat(interleaved + frame * numChannels + channel, chunk, numChunkFrames * numChunkChannels, dither);
+        }
+    }
+}
+
+} // namespace SampleFormat
+} // namespace slb
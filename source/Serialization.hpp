@@ -0,0 +1,254 @@
+//
+//  ╦ ╦┬ ┬┌─┐┌─┐┬─┐  ╔╗ ┬ ┬┌─┐┌─┐┌─┐┬─┐
+//  ╠═╣└┬┘├─┘├┤ ├┬┘  ╠╩╗│ │├┤ ├┤ ├┤ ├┬┘
+//  ╩ ╩ ┴ ┴  └─┘┴└─  ╚═╝└─┘└  └  └─┘┴└─
+//
+//  © 2023 Lorenz Bucher - all rights reserved
+//  https://github.com/Sidelobe/HyperBuffer
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <type_traits>
+
+#include "HyperBuffer.hpp"
+#include "HyperBufferMapped.hpp"
+
+namespace slb
+{
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Binary serialization of HyperBuffers with contiguous data.
+//
+// The format is a self-describing header followed by the data array, exactly as it is laid out in memory (including
+// the padding of the rows, if any). Loading therefore requires no parsing and no copy: the data of a serialized
+// blob / file is accessed in place through a HyperBufferView / HyperBufferMapped.
+//
+//  | offset      | content                                                                       |
+//  |-------------|-------------------------------------------------------------------------------|
+//  | 0           | Header: magic, version, byte order mark, type tag, N, alignment, innermost     |
+//  |             | stride, data offset, data size (bytes), checksum of the data (FNV-1a, 64-bit) |
+//  | 48          | extents of the N dimensions (int32)                                           |
+//  | data offset | data array, aligned to `alignment` relative to the start of the blob          |
+//
+// All values are stored in the byte order of the writer. Since the data is used in place, blobs written on a machine
+// with a different byte order are rejected.
+// ---------------------------------------------------------------------------------------------------------------------
+namespace Serialization
+{
+/** Alignment of the data array (relative to the start of the blob), suitable for any SIMD instruction set */
+static constexpr std::size_t DataAlignment = 64;
+
+struct Header
+{
+    char magic[4];
+    std::uint16_t version;
+    std::uint16_t byteOrderMark;
+    std::uint32_t typeTag;
+    std::uint32_t numDimensions;
+    std::uint32_t alignment;
+    std::int32_t innermostStride;
+    std::uint64_t dataOffset;
+    std::uint64_t dataSize;
+    std::uint64_t checksum;
+};
+static_assert(sizeof(Header) == 48 && std::is_trivially_copyable<Header>::value, "Unexpected header layout");
+
+/** @returns the 64-bit FNV-1a hash of the given bytes */
+inline std::uint64_t computeChecksum(const void* data, std::size_t numBytes) noexcept
+{
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    std::uint64_t hash = 0xcbf29ce484222325ull;
+    for (std::size_t i = 0; i < numBytes; ++i) {
+        hash = (hash ^ bytes[i]) * 0x100000001b3ull;
+    }
+    return hash;
+}
+
+namespace detail
+{
+static constexpr char Magic[4] { 'H', 'Y', 'P', 'B' };
+static constexpr std::uint16_t Version = 1;
+static constexpr std::uint16_t ByteOrderMark = 0xFEFF;
+
+/** @returns an identifier of the data type: kind of type (float, signed, unsigned, other) and size in bytes */
+template<typename T>
+constexpr std::uint32_t getTypeTag() noexcept
+{
+    using U = std::remove_cv_t<T>;
+    const std::uint32_t kind = std::is_floating_point<U>::value ? 3 : (std::is_signed<U>::value ? 2 : (std::is_integral<U>::value ? 1 : 0));
+    return (kind << 16) | static_cast<std::uint32_t>(sizeof(U));
+}
+
+constexpr std::uint64_t roundUp(std::uint64_t value, std::uint64_t alignment) noexcept
+{
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+template<int N>
+constexpr std::uint64_t getDataOffset() noexcept
+{
+    return roundUp(sizeof(Header) + N * sizeof(std::int32_t), DataAlignment);
+}
+
+/** @returns the geometry of the buffer's data array, derived from its extents and strides */
+template<typename T, int N, class StoragePolicy>
+BufferGeometry<N> getGeometry(const HyperBuffer<T, N, StoragePolicy>& buffer)
+{
+    static_assert(StoragePolicy::IsContiguous, "Only buffers with contiguous data can be serialized");
+    const int innermostStride = (N > 1) ? static_cast<int>(buffer.stridedView().stride(N-2)) : buffer.size(N-1);
+    return BufferGeometry<N>(buffer.sizes(), innermostStride);
+}
+
+template<typename T, int N>
+Header createHeader(const BufferGeometry<N>& geometry, const void* data)
+{
+    Header header {};
+    std::memcpy(header.magic, Magic, sizeof(Magic));
+    header.version = Version;
+    header.byteOrderMark = ByteOrderMark;
+    header.typeTag = getTypeTag<T>();
+    header.numDimensions = N;
+    header.alignment = DataAlignment;
+    header.innermostStride = geometry.getInnermostStride();
+    header.dataOffset = getDataOffset<N>();
+    header.dataSize = static_cast<std::uint64_t>(geometry.getRequiredDataArraySize()) * sizeof(T);
+    header.checksum = computeChecksum(data, header.dataSize);
+    return header;
+}
+
+/** Validates the header and extents at the start of a blob; @returns the geometry of the data array */
+template<typename T, int N>
+BufferGeometry<N> parseHeader(const void* blob, std::size_t blobSize, Header& header)
+{
+    ASSERT(blobSize >= sizeof(Header) + N * sizeof(std::int32_t), "Blob is too short");
+    std::memcpy(&header, blob, sizeof(Header));
+    ASSERT(std::memcmp(header.magic, Magic, sizeof(Magic)) == 0, "Not a serialized HyperBuffer");
+    ASSERT(header.version == Version, "Unsupported version");
+    ASSERT(header.byteOrderMark == ByteOrderMark, "Byte order of the data does not match this machine");
+    ASSERT(header.typeTag == getTypeTag<T>(), "Data type does not match");
+    ASSERT(header.numDimensions == N, "Number of dimensions does not match");
+    ASSERT(header.dataOffset >= getDataOffset<N>() && header.dataOffset % alignof(T) == 0, "Invalid data offset");
+
+    std::array<std::int32_t, N> extents;
+    std::memcpy(extents.data(), static_cast<const char*>(blob) + sizeof(Header), sizeof(extents));
+    std::array<int, N> dimensionExtents;
+    for (int i=0; i < N; ++i) {
+        ASSERT(extents[i] > 0, "Invalid Dimension extents");
+        dimensionExtents[i] = extents[i];
+    }
+    BufferGeometry<N> geometry(dimensionExtents, header.innermostStride);
+    ASSERT(header.dataSize == static_cast<std::uint64_t>(geometry.getRequiredDataArraySize()) * sizeof(T), "Invalid data size");
+    return geometry;
+}
+} // namespace detail
+
+/** @returns the number of bytes required to serialize the given buffer */
+template<typename T, int N, class StoragePolicy>
+std::size_t getSerializedSize(const HyperBuffer<T, N, StoragePolicy>& buffer)
+{
+    const BufferGeometry<N> geometry = detail::getGeometry(buffer);
+    return static_cast<std::size_t>(detail::getDataOffset<N>() + static_cast<std::uint64_t>(geometry.getRequiredDataArraySize()) * sizeof(T));
+}
+
+/**
+ * Writes the buffer to the given memory blob, which has to be at least `getSerializedSize(buffer)` bytes long.
+ * @returns the number of bytes written
+ */
+template<typename T, int N, class StoragePolicy>
+std::size_t serialize(const HyperBuffer<T, N, StoragePolicy>& buffer, void* blob, std::size_t blobSize)
+{
+    static_assert(std::is_trivially_copyable<T>::value, "Data type must be trivially copyable");
+    const std::size_t serializedSize = getSerializedSize(buffer);
+    ASSERT(blobSize >= serializedSize, "Blob is too short");
+
+    const BufferGeometry<N> geometry = detail::getGeometry(buffer);
+    const T* data = buffer.stridedView().data();
+    const Header header = detail::createHeader<T>(geometry, data);
+
+    char* bytes = static_cast<char*>(blob);
+    std::memset(bytes, 0, header.dataOffset);
+    std::memcpy(bytes, &header, sizeof(Header));
+    for (int i=0; i < N; ++i) {
+        const std::int32_t extent = buffer.size(i);
+        std::memcpy(bytes + sizeof(Header) + i * sizeof(std::int32_t), &extent, sizeof(extent));
+    }
+    std::memcpy(bytes + header.dataOffset, data, header.dataSize);
+    return serializedSize;
+}
+
+/**
+ * Creates a view to a serialized buffer: the data is used in place (no copy). The blob has to outlive the view, and
+ * has to be aligned to at least the alignment of T. T can be const (for a const blob).
+ * @note verifying the checksum requires a pass over the entire data.
+ */
+template<typename T, int N>
+HyperBufferView<T, N> deserialize(std::conditional_t<std::is_const<T>::value, const void*, void*> blob, std::size_t blobSize,
+                                  bool verifyChecksum = true)
+{
+    Header header;
+    const BufferGeometry<N> geometry = detail::parseHeader<T, N>(blob, blobSize, header);
+    ASSERT(header.dataOffset <= blobSize && header.dataSize <= blobSize - header.dataOffset, "Blob is too short");
+
+    T* data = reinterpret_cast<T*>(static_cast<std::conditional_t<std::is_const<T>::value, const char*, char*>>(blob) + header.dataOffset);
+    ASSERT(reinterpret_cast<std::uintptr_t>(data) % alignof(T) == 0, "Data is misaligned");
+    ASSERT(!verifyChecksum || computeChecksum(data, header.dataSize) == header.checksum, "Checksum mismatch");
+    return HyperBufferView<T, N>(data, geometry);
+}
+
+/** Writes the buffer to a file (header and data array, each in a single write) */
+template<typename T, int N, class StoragePolicy>
+void writeFile(const HyperBuffer<T, N, StoragePolicy>& buffer, const std::string& path)
+{
+    static_assert(std::is_trivially_copyable<T>::value, "Data type must be trivially copyable");
+    const BufferGeometry<N> geometry = detail::getGeometry(buffer);
+    const T* data = buffer.stridedView().data();
+    const Header header = detail::createHeader<T>(geometry, data);
+
+    std::array<char, detail::getDataOffset<N>()> headerBytes {};
+    std::memcpy(headerBytes.data(), &header, sizeof(Header));
+    for (int i=0; i < N; ++i) {
+        const std::int32_t extent = buffer.size(i);
+        std::memcpy(headerBytes.data() + sizeof(Header) + i * sizeof(std::int32_t), &extent, sizeof(extent));
+    }
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file.write(headerBytes.data(), static_cast<std::streamsize>(headerBytes.size()));
+    file.write(reinterpret_cast<const char*>(data), static_cast<std::streamsize>(header.dataSize));
+    ASSERT(file.good(), "Cannot write file");
+}
+
+/**
+ * Memory-maps a serialized buffer from a file: the data is used in place, and paged in lazily.
+ * The default mode is ReadOnly for a const T, CopyOnWrite otherwise (@see MappedFile::Mode).
+ * @note verifying the checksum requires a pass over the entire data, i.e. pages in all of it.
+ */
+template<typename T, int N>
+HyperBufferMapped<T, N> readFile(const std::string& path,
+                                 MappedFile::Mode mode = std::is_const<T>::value ? MappedFile::Mode::ReadOnly
+                                                                                 : MappedFile::Mode::CopyOnWrite,
+                                 bool verifyChecksum = false)
+{
+    std::array<char, sizeof(Header) + N * sizeof(std::int32_t)> headerBytes;
+    std::ifstream file(path, std::ios::binary);
+    file.read(headerBytes.data(), static_cast<std::streamsize>(headerBytes.size()));
+    ASSERT(file.good(), "Cannot read file");
+
+    Header header;
+    const BufferGeometry<N> geometry = detail::parseHeader<T, N>(headerBytes.data(), headerBytes.size(), header);
+    MappedFile::Options options;
+    options.mode = mode;
+    options.offset = header.dataOffset;
+    HyperBufferMapped<T, N> buffer(path, options, geometry);
+    ASSERT(!verifyChecksum || computeChecksum(buffer.stridedView().data(), header.dataSize) == header.checksum,
+           "Checksum mismatch");
+    return buffer;
+}
+
+} // namespace Serialization
+} // namespace slb
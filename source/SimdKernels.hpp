@@ -0,0 +1,669 @@
+//
+//  ╦ ╦┬ ┬┌─┐┌─┐┬─┐  ╔╗ ┬ ┬┌─┐┌─┐┌─┐┬─┐
+//  ╠═╣└┬┘├─┘├┤ ├┬┘  ╠╩╗│ │├┤ ├┤ ├┤ ├┬┘
+//  ╩ ╩ ┴ ┴  └─┘┴└─  ╚═╝└─┘└  └  └─┘┴└─
+//
+//  © 2023 Lorenz Bucher - all rights reserved
+//  https://github.com/Sidelobe/HyperBuffer
+
+#pragma once
+
+#include <type_traits>
+
+#include "TemplateUtils.hpp"
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Instruction set selection -- resolved at compile time from the compiler's target flags (e.g. -mavx2, /arch:AVX2).
+// Define SLB_DISABLE_SIMD to force the scalar implementation.
+// ---------------------------------------------------------------------------------------------------------------------
+#if !defined(SLB_DISABLE_SIMD)
+  #if defined(__AVX512F__)
+    #define SLB_SIMD_AVX512
+  #elif defined(__AVX__)
+    #define SLB_SIMD_AVX
+  #elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #define SLB_SIMD_SSE
+  #elif defined(__ARM_NEON) || defined(__ARM_NEON__) || defined(_M_ARM64)
+    #define SLB_SIMD_NEON
+  #endif
+#endif
+
+#if defined(SLB_SIMD_AVX512) || defined(SLB_SIMD_AVX)
+  #include <immintrin.h>
+#elif defined(SLB_SIMD_SSE)
+  #include <emmintrin.h>
+#elif defined(SLB_SIMD_NEON)
+  #include <arm_neon.h>
+#endif
+
+namespace slb
+{
+
+// MARK: - SIMD packs
+/**
+ * Thin wrapper around the vector registers of the selected instruction set: a pack of `Width` elements of type T.
+ * Types without vectorized support have Width=1 and are processed by the scalar fallback.
+ * min() and max() propagate NaN (like the scalar SimdKernels::detail::min/max) on all instruction sets.
+ */
+template<typename T>
+struct SimdPack
+{
+    static constexpr int Width = 1;
+};
+
+#if defined(SLB_SIMD_AVX512)
+template<>
+struct SimdPack<float>
+{
+    using Register = __m512;
+    static constexpr int Width = 16;
+    static Register load(const float* p) noexcept { return _mm512_loadu_ps(p); }
+    static void store(float* p, Register r) noexcept { _mm512_storeu_ps(p, r); }
+    static Register broadcast(float v) noexcept { return _mm512_set1_ps(v); }
+    static Register add(Register a, Register b) noexcept { return _mm512_add_ps(a, b); }
+    static Register sub(Register a, Register b) noexcept { return _mm512_sub_ps(a, b); }
+    static Register mul(Register a, Register b) noexcept { return _mm512_mul_ps(a, b); }
+    static Register min(Register a, Register b) noexcept { return _mm512_mask_add_ps(_mm512_min_ps(a, b), _mm512_cmp_ps_mask(a, b, _CMP_UNORD_Q), a, b); }
+    static Register max(Register a, Register b) noexcept { return _mm512_mask_add_ps(_mm512_max_ps(a, b), _mm512_cmp_ps_mask(a, b, _CMP_UNORD_Q), a, b); }
+};
+
+template<>
+struct SimdPack<double>
+{
+    using Register = __m512d;
+    static constexpr int Width = 8;
+    static Register load(const double* p) noexcept { return _mm512_loadu_pd(p); }
+    static void store(double* p, Register r) noexcept { _mm512_storeu_pd(p, r); }
+    static Register broadcast(double v) noexcept { return _mm512_set1_pd(v); }
+    static Register add(Register a, Register b) noexcept { return _mm512_add_pd(a, b); }
+    static Register sub(Register a, Register b) noexcept { return _mm512_sub_pd(a, b); }
+    static Register mul(Register a, Register b) noexcept { return _mm512_mul_pd(a, b); }
+    static Register min(Register a, Register b) noexcept { return _mm512_mask_add_pd(_mm512_min_pd(a, b), _mm512_cmp_pd_mask(a, b, _CMP_UNORD_Q), a, b); }
+    static Register max(Register a, Register b) noexcept { return _mm512_mask_add_pd(_mm512_max_pd(a, b), _mm512_cmp_pd_mask(a, b, _CMP_UNORD_Q), a, b); }
+};
+
+#elif defined(SLB_SIMD_AVX)
+template<>
+struct SimdPack<float>
+{
+    using Register = __m256;
+    static constexpr int Width = 8;
+    static Register load(const float* p) noexcept { return _mm256_loadu_ps(p); }
+    static void store(float* p, Register r) noexcept { _mm256_storeu_ps(p, r); }
+    static Register broadcast(float v) noexcept { return _mm256_set1_ps(v); }
+    static Register add(Register a, Register b) noexcept { return _mm256_add_ps(a, b); }
+    static Register sub(Register a, Register b) noexcept { return _mm256_sub_ps(a, b); }
+    static Register mul(Register a, Register b) noexcept { return _mm256_mul_ps(a, b); }
+    static Register min(Register a, Register b) noexcept { return _mm256_or_ps(_mm256_min_ps(a, b), _mm256_cmp_ps(a, b, _CMP_UNORD_Q)); }
+    static Register max(Register a, Register b) noexcept { return _mm256_or_ps(_mm256_max_ps(a, b), _mm256_cmp_ps(a, b, _CMP_UNORD_Q)); }
+};
+
+template<>
+struct SimdPack<double>
+{
+    using Register = __m256d;
+    static constexpr int Width = 4;
+    static Register load(const double* p) noexcept { return _mm256_loadu_pd(p); }
+    static void store(double* p, Register r) noexcept { _mm256_storeu_pd(p, r); }
+    static Register broadcast(double v) noexcept { return _mm256_set1_pd(v); }
+    static Register add(Register a, Register b) noexcept { return _mm256_add_pd(a, b); }
+    static Register sub(Register a, Register b) noexcept { return _mm256_sub_pd(a, b); }
+    static Register mul(Register a, Register b) noexcept { return _mm256_mul_pd(a, b); }
+    static Register min(Register a, Register b) noexcept { return _mm256_or_pd(_mm256_min_pd(a, b), _mm256_cmp_pd(a, b, _CMP_UNORD_Q)); }
+    static Register max(Register a, Register b) noexcept { return _mm256_or_pd(_mm256_max_pd(a, b), _mm256_cmp_pd(a, b, _CMP_UNORD_Q)); }
+};
+
+#elif defined(SLB_SIMD_SSE)
+template<>
+struct SimdPack<float>
+{
+    using Register = __m128;
+    static constexpr int Width = 4;
+    static Register load(const float* p) noexcept { return _mm_loadu_ps(p); }
+    static void store(float* p, Register r) noexcept { _mm_storeu_ps(p, r); }
+    static Register broadcast(float v) noexcept { return _mm_set1_ps(v); }
+    static Register add(Register a, Register b) noexcept { return _mm_add_ps(a, b); }
+    static Register sub(Register a, Register b) noexcept { return _mm_sub_ps(a, b); }
+    static Register mul(Register a, Register b) noexcept { return _mm_mul_ps(a, b); }
+    static Register min(Register a, Register b) noexcept { return _mm_or_ps(_mm_min_ps(a, b), _mm_cmpunord_ps(a, b)); }
+    static Register max(Register a, Register b) noexcept { return _mm_or_ps(_mm_max_ps(a, b), _mm_cmpunord_ps(a, b)); }
+};
+
+template<>
+struct SimdPack<double>
+{
+    using Register = __m128d;
+    static constexpr int Width = 2;
+    static Register load(const double* p) noexcept { return _mm_loadu_pd(p); }
+    static void store(double* p, Register r) noexcept { _mm_storeu_pd(p, r); }
+    static Register broadcast(double v) noexcept { return _mm_set1_pd(v); }
+    static Register add(Register a, Register b) noexcept { return _mm_add_pd(a, b); }
+    static Register sub(Register a, Register b) noexcept { return _mm_sub_pd(a, b); }
+    static Register mul(Register a, Register b) noexcept { return _mm_mul_pd(a, b); }
+    static Register min(Register a, Register b) noexcept { return _mm_or_pd(_mm_min_pd(a, b), _mm_cmpunord_pd(a, b)); }
+    static Register max(Register a, Register b) noexcept { return _mm_or_pd(_mm_max_pd(a, b), _mm_cmpunord_pd(a, b)); }
+};
+
+#elif defined(SLB_SIMD_NEON)
+template<>
+struct SimdPack<float>
+{
+    using Register = float32x4_t;
+    static constexpr int Width = 4;
+    static Register load(const float* p) noexcept { return vld1q_f32(p); }
+    static void store(float* p, Register r) noexcept { vst1q_f32(p, r); }
+    static Register broadcast(float v) noexcept { return vdupq_n_f32(v); }
+    static Register add(Register a, Register b) noexcept { return vaddq_f32(a, b); }
+    static Register sub(Register a, Register b) noexcept { return vsubq_f32(a, b); }
+    static Register mul(Register a, Register b) noexcept { return vmulq_f32(a, b); }
+    static Register min(Register a, Register b) noexcept { return vminq_f32(a, b); }
+    static Register max(Register a, Register b) noexcept { return vmaxq_f32(a, b); }
+};
+
+#if defined(__aarch64__) || defined(_M_ARM64)
+template<>
+struct SimdPack<double>
+{
+    using Register = float64x2_t;
+    static constexpr int Width = 2;
+    static Register load(const double* p) noexcept { return vld1q_f64(p); }
+    static void store(double* p, Register r) noexcept { vst1q_f64(p, r); }
+    static Register broadcast(double v) noexcept { return vdupq_n_f64(v); }
+    static Register add(Register a, Register b) noexcept { return vaddq_f64(a, b); }
+    static Register sub(Register a, Register b) noexcept { return vsubq_f64(a, b); }
+    static Register mul(Register a, Register b) noexcept { return vmulq_f64(a, b); }
+    static Register min(Register a, Register b) noexcept { return vminq_f64(a, b); }
+    static Register max(Register a, Register b) noexcept { return vmaxq_f64(a, b); }
+};
+#endif
+#endif
+
+// MARK: - Interleaving
+/**
+ * Shuffles between 4 interleaved frames and 4 channels (float only): 4x4 transpositions and (de-)interleaving of 2
+ * channels. Used for any interleaved stream with 2 or at least 4 channels, on all instruction sets.
+ */
+#if defined(SLB_SIMD_AVX512) || defined(SLB_SIMD_AVX) || defined(SLB_SIMD_SSE)
+  #define SLB_SIMD_INTERLEAVE
+struct SimdInterleave
+{
+    /** d[c][i] = src[i * stride + c] for 4 channels c and 4 frames i */
+    static void deinterleave4(const float* src, offset_type stride, float* d0, float* d1, float* d2, float* d3) noexcept
+    {
+        __m128 r0 = _mm_loadu_ps(src);
+        __m128 r1 = _mm_loadu_ps(src + stride);
+        __m128 r2 = _mm_loadu_ps(src + 2*stride);
+        __m128 r3 = _mm_loadu_ps(src + 3*stride);
+        _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+        _mm_storeu_ps(d0, r0);
+        _mm_storeu_ps(d1, r1);
+        _mm_storeu_ps(d2, r2);
+        _mm_storeu_ps(d3, r3);
+    }
+
+    /** dst[i * stride + c] = s[c][i] for 4 channels c and 4 frames i */
+    static void interleave4(const float* s0, const float* s1, const float* s2, const float* s3, float* dst, offset_type stride) noexcept
+    {
+        __m128 r0 = _mm_loadu_ps(s0);
+        __m128 r1 = _mm_loadu_ps(s1);
+        __m128 r2 = _mm_loadu_ps(s2);
+        __m128 r3 = _mm_loadu_ps(s3);
+        _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+        _mm_storeu_ps(dst, r0);
+        _mm_storeu_ps(dst + stride, r1);
+        _mm_storeu_ps(dst + 2*stride, r2);
+        _mm_storeu_ps(dst + 3*stride, r3);
+    }
+
+    /** d0[i] = src[2i], d1[i] = src[2i+1] for 4 frames i */
+    static void deinterleave2(const float* src, float* d0, float* d1) noexcept
+    {
+        const __m128 low = _mm_loadu_ps(src);
+        const __m128 high = _mm_loadu_ps(src + 4);
+        _mm_storeu_ps(d0, _mm_shuffle_ps(low, high, _MM_SHUFFLE(2, 0, 2, 0)));
+        _mm_storeu_ps(d1, _mm_shuffle_ps(low, high, _MM_SHUFFLE(3, 1, 3, 1)));
+    }
+
+    /** dst[2i] = s0[i], dst[2i+1] = s1[i] for 4 frames i */
+    static void interleave2(const float* s0, const float* s1, float* dst) noexcept
+    {
+        const __m128 a = _mm_loadu_ps(s0);
+        const __m128 b = _mm_loadu_ps(s1);
+        _mm_storeu_ps(dst, _mm_unpacklo_ps(a, b));
+        _mm_storeu_ps(dst + 4, _mm_unpackhi_ps(a, b));
+    }
+};
+
+#elif defined(SLB_SIMD_NEON)
+  #define SLB_SIMD_INTERLEAVE
+struct SimdInterleave
+{
+    static void transpose(float32x4_t& r0, float32x4_t& r1, float32x4_t& r2, float32x4_t& r3) noexcept
+    {
+        const float32x4x2_t t01 = vtrnq_f32(r0, r1);
+        const float32x4x2_t t23 = vtrnq_f32(r2, r3);
+        r0 = vcombine_f32(vget_low_f32(t01.val[0]), vget_low_f32(t23.val[0]));
+        r1 = vcombine_f32(vget_low_f32(t01.val[1]), vget_low_f32(t23.val[1]));
+        r2 = vcombine_f32(vget_high_f32(t01.val[0]), vget_high_f32(t23.val[0]));
+        r3 = vcombine_f32(vget_high_f32(t01.val[1]), vget_high_f32(t23.val[1]));
+    }
+
+    static void deinterleave4(const float* src, offset_type stride, float* d0, float* d1, float* d2, float* d3) noexcept
+    {
+        float32x4_t r0 = vld1q_f32(src);
+        float32x4_t r1 = vld1q_f32(src + stride);
+        float32x4_t r2 = vld1q_f32(src + 2*stride);
+        float32x4_t r3 = vld1q_f32(src + 3*stride);
+        transpose(r0, r1, r2, r3);
+        vst1q_f32(d0, r0);
+        vst1q_f32(d1, r1);
+        vst1q_f32(d2, r2);
+        vst1q_f32(d3, r3);
+    }
+
+    static void interleave4(const float* s0, const float* s1, const float* s2, const float* s3, float* dst, offset_type stride) noexcept
+    {
+        float32x4_t r0 = vld1q_f32(s0);
+        float32x4_t r1 = vld1q_f32(s1);
+        float32x4_t r2 = vld1q_f32(s2);
+        float32x4_t r3 = vld1q_f32(s3);
+        transpose(r0, r1, r2, r3);
+        vst1q_f32(dst, r0);
+        vst1q_f32(dst + stride, r1);
+        vst1q_f32(dst + 2*stride, r2);
+        vst1q_f32(dst + 3*stride, r3);
+    }
+
+    static void deinterleave2(const float* src, float* d0, float* d1) noexcept
+    {
+        const float32x4x2_t channels = vld2q_f32(src);
+        vst1q_f32(d0, channels.val[0]);
+        vst1q_f32(d1, channels.val[1]);
+    }
+
+    static void interleave2(const float* s0, const float* s1, float* dst) noexcept
+    {
+        vst2q_f32(dst, float32x4x2_t {{ vld1q_f32(s0), vld1q_f32(s1) }});
+    }
+};
+#endif
+
+// MARK: - Kernels
+/**
+ * Element-wise operations on flat arrays of `n` elements. Types with a SimdPack specialization (float, double) are
+ * processed pack by pack with a scalar tail; all other types use the scalar loop only.
+ *
+ * @note Multiply-accumulate is computed as a separate multiply and add (no FMA), so the vectorized and the scalar
+ * results are identical.
+ */
+namespace SimdKernels
+{
+namespace detail
+{
+template<typename T>
+using IsVectorized = std::integral_constant<bool, (SimdPack<T>::Width > 1)>;
+
+/** Scalar minimum & maximum with the semantics of SimdPack::min/max: NaN if any of the operands is NaN */
+template<typename T>
+inline T min(T a, T b) noexcept { return (a < b || a != a) ? a : b; }
+
+template<typename T>
+inline T max(T a, T b) noexcept { return (b < a || a != a) ? a : b; }
+
+/** Applies `vectorOp(pack, i)` to every full pack, and `scalarOp(i)` to the remaining elements */
+template<typename T, class VectorOp, class ScalarOp>
+inline void forEachIndex(std::true_type /*vectorized*/, offset_type n, VectorOp&& vectorOp, ScalarOp&& scalarOp) noexcept
+{
+    constexpr int W = SimdPack<T>::Width;
+    offset_type i = 0;
+    for (; i + W <= n; i += W) {
+        vectorOp(SimdPack<T>{}, i);
+    }
+    for (; i < n; ++i) {
+        scalarOp(i);
+    }
+}
+
+template<typename T, class VectorOp, class ScalarOp>
+inline void forEachIndex(std::false_type /*vectorized*/, offset_type n, VectorOp&&, ScalarOp&& scalarOp) noexcept
+{
+    for (offset_type i = 0; i < n; ++i) {
+        scalarOp(i);
+    }
+}
+
+template<typename T, class VectorOp, class ScalarOp>
+inline void forEachIndex(offset_type n, VectorOp&& vectorOp, ScalarOp&& scalarOp) noexcept
+{
+    forEachIndex<T>(IsVectorized<T>{}, n, std::forward<VectorOp>(vectorOp), std::forward<ScalarOp>(scalarOp));
+}
+} // namespace detail
+
+/** dst[i] = value */
+template<typename T>
+inline void fill(T* dst, T value, offset_type n) noexcept
+{
+    detail::forEachIndex<T>(n,
+        [=](auto p, offset_type i) { using P = decltype(p); P::store(dst+i, P::broadcast(value)); },
+        [=](offset_type i) { dst[i] = value; });
+}
+
+/** dst[i] = src[i] */
+template<typename T>
+inline void copy(T* dst, const T* src, offset_type n) noexcept
+{
+    detail::forEachIndex<T>(n,
+        [=](auto p, offset_type i) { using P = decltype(p); P::store(dst+i, P::load(src+i)); },
+        [=](offset_type i) { dst[i] = src[i]; });
+}
+
+/** dst[i] += src[i] */
+template<typename T>
+inline void add(T* dst, const T* src, offset_type n) noexcept
+{
+    detail::forEachIndex<T>(n,
+        [=](auto p, offset_type i) { using P = decltype(p); P::store(dst+i, P::add(P::load(dst+i), P::load(src+i))); },
+        [=](offset_type i) { dst[i] += src[i]; });
+}
+
+/** dst[i] -= src[i] */
+template<typename T>
+inline void subtract(T* dst, const T* src, offset_type n) noexcept
+{
+    detail::forEachIndex<T>(n,
+        [=](auto p, offset_type i) { using P = decltype(p); P::store(dst+i, P::sub(P::load(dst+i), P::load(src+i))); },
+        [=](offset_type i) { dst[i] -= src[i]; });
+}
+
+/** dst[i] *= src[i] */
+template<typename T>
+inline void multiply(T* dst, const T* src, offset_type n) noexcept
+{
+    detail::forEachIndex<T>(n,
+        [=](auto p, offset_type i) { using P = decltype(p); P::store(dst+i, P::mul(P::load(dst+i), P::load(src+i))); },
+        [=](offset_type i) { dst[i] *= src[i]; });
+}
+
+/** dst[i] *= gain */
+template<typename T>
+inline void scale(T* dst, T gain, offset_type n) noexcept
+{
+    detail::forEachIndex<T>(n,
+        [=](auto p, offset_type i) { using P = decltype(p); P::store(dst+i, P::mul(P::load(dst+i), P::broadcast(gain))); },
+        [=](offset_type i) { dst[i] *= gain; });
+}
+
+/** dst[i] += src[i] * gain */
+template<typename T>
+inline void multiplyAccumulate(T* dst, const T* src, T gain, offset_type n) noexcept
+{
+    detail::forEachIndex<T>(n,
+        [=](auto p, offset_type i) {
+            using P = decltype(p);
+            P::store(dst+i, P::add(P::load(dst+i), P::mul(P::load(src+i), P::broadcast(gain))));
+        },
+        [=](offset_type i) { dst[i] += src[i] * gain; });
+}
+
+/** dst[i] += a[i] * b[i] */
+template<typename T>
+inline void multiplyAccumulate(T* dst, const T* a, const T* b, offset_type n) noexcept
+{
+    detail::forEachIndex<T>(n,
+        [=](auto p, offset_type i) {
+            using P = decltype(p);
+            P::store(dst+i, P::add(P::load(dst+i), P::mul(P::load(a+i), P::load(b+i))));
+        },
+        [=](offset_type i) { dst[i] += a[i] * b[i]; });
+}
+
+/** dst[i] = min(max(dst[i], low), high); NaN remains NaN */
+template<typename T>
+inline void clamp(T* dst, T low, T high, offset_type n) noexcept
+{
+    detail::forEachIndex<T>(n,
+        [=](auto p, offset_type i) {
+            using P = decltype(p);
+            P::store(dst+i, P::min(P::max(P::load(dst+i), P::broadcast(low)), P::broadcast(high)));
+        },
+        [=](offset_type i) { dst[i] = detail::min(detail::max(dst[i], low), high); });
+}
+
+/** dst[i] = min(dst[i], src[i]); NaN if either is NaN */
+template<typename T>
+inline void accumulateMin(T* dst, const T* src, offset_type n) noexcept
+{
+    detail::forEachIndex<T>(n,
+        [=](auto p, offset_type i) { using P = decltype(p); P::store(dst+i, P::min(P::load(dst+i), P::load(src+i))); },
+        [=](offset_type i) { dst[i] = detail::min(dst[i], src[i]); });
+}
+
+/** dst[i] = max(dst[i], src[i]); NaN if either is NaN */
+template<typename T>
+inline void accumulateMax(T* dst, const T* src, offset_type n) noexcept
+{
+    detail::forEachIndex<T>(n,
+        [=](auto p, offset_type i) { using P = decltype(p); P::store(dst+i, P::max(P::load(dst+i), P::load(src+i))); },
+        [=](offset_type i) { dst[i] = detail::max(dst[i], src[i]); });
+}
+
+/** dst[i] = max(dst[i], |src[i]|); NaN if either is NaN */
+template<typename T>
+inline void accumulatePeak(T* dst, const T* src, offset_type n) noexcept
+{
+    detail::forEachIndex<T>(n,
+        [=](auto p, offset_type i) {
+            using P = decltype(p);
+            const auto x = P::load(src+i);
+            P::store(dst+i, P::max(P::load(dst+i), P::max(x, P::sub(P::broadcast(T(0)), x))));
+        },
+        [=](offset_type i) {
+            const T x = (src[i] < T(0)) ? T(0) - src[i] : src[i];
+            dst[i] = detail::max(dst[i], x);
+        });
+}
+
+// MARK: - Reductions
+namespace detail
+{
+/** Reduction operations: accumulation of an element (vector & scalar) and combination of two partial results */
+struct SumOp
+{
+    template<class P, class R> static R accumulate(P, R acc, R x) noexcept { return P::add(acc, x); }
+    template<class P, class R> static R combine(P, R a, R b) noexcept { return P::add(a, b); }
+    template<typename T> static T accumulate(T acc, T x) noexcept { return acc + x; }
+    template<typename T> static T combine(T a, T b) noexcept { return a + b; }
+};
+
+struct SumOfSquaresOp
+{
+    template<class P, class R> static R accumulate(P, R acc, R x) noexcept { return P::add(acc, P::mul(x, x)); }
+    template<class P, class R> static R combine(P, R a, R b) noexcept { return P::add(a, b); }
+    template<typename T> static T accumulate(T acc, T x) noexcept { return acc + x * x; }
+    template<typename T> static T combine(T a, T b) noexcept { return a + b; }
+};
+
+struct MinOp
+{
+    template<class P, class R> static R accumulate(P, R acc, R x) noexcept { return P::min(acc, x); }
+    template<class P, class R> static R combine(P, R a, R b) noexcept { return P::min(a, b); }
+    template<typename T> static T accumulate(T acc, T x) noexcept { return min(acc, x); }
+    template<typename T> static T combine(T a, T b) noexcept { return min(a, b); }
+};
+
+struct MaxOp
+{
+    template<class P, class R> static R accumulate(P, R acc, R x) noexcept { return P::max(acc, x); }
+    template<class P, class R> static R combine(P, R a, R b) noexcept { return P::max(a, b); }
+    template<typename T> static T accumulate(T acc, T x) noexcept { return max(acc, x); }
+    template<typename T> static T combine(T a, T b) noexcept { return max(a, b); }
+};
+
+struct PeakOp
+{
+    template<class P, class R> static R accumulate(P, R acc, R x) noexcept { return P::max(acc, P::max(x, P::sub(P::broadcast(0), x))); }
+    template<class P, class R> static R combine(P, R a, R b) noexcept { return P::max(a, b); }
+    template<typename T> static T accumulate(T acc, T x) noexcept { return MaxOp::accumulate(acc, (x < T(0)) ? T(0) - x : x); }
+    template<typename T> static T combine(T a, T b) noexcept { return MaxOp::combine(a, b); }
+};
+
+/** Reduces `n` elements, starting from `initial`, with 4 independent vector accumulators (hides the latency of the ops) */
+template<typename T, class Op>
+inline T reduce(std::true_type /*vectorized*/, const T* src, offset_type n, T initial) noexcept
+{
+    using P = SimdPack<T>;
+    constexpr int W = P::Width;
+    auto acc0 = P::broadcast(initial);
+    auto acc1 = acc0, acc2 = acc0, acc3 = acc0;
+    offset_type i = 0;
+    for (; i + 4*W <= n; i += 4*W) {
+        acc0 = Op::accumulate(P{}, acc0, P::load(src + i));
+        acc1 = Op::accumulate(P{}, acc1, P::load(src + i + W));
+        acc2 = Op::accumulate(P{}, acc2, P::load(src + i + 2*W));
+        acc3 = Op::accumulate(P{}, acc3, P::load(src + i + 3*W));
+    }
+    for (; i + W <= n; i += W) {
+        acc0 = Op::accumulate(P{}, acc0, P::load(src + i));
+    }
+    T lanes[W];
+    P::store(lanes, Op::combine(P{}, Op::combine(P{}, acc0, acc1), Op::combine(P{}, acc2, acc3)));
+    T result = lanes[0];
+    for (int lane = 1; lane < W; ++lane) {
+        result = Op::combine(result, lanes[lane]);
+    }
+    for (; i < n; ++i) {
+        result = Op::accumulate(result, src[i]);
+    }
+    return result;
+}
+
+template<typename T, class Op>
+inline T reduce(std::false_type /*vectorized*/, const T* src, offset_type n, T initial) noexcept
+{
+    T result = initial;
+    for (offset_type i = 0; i < n; ++i) {
+        result = Op::accumulate(result, src[i]);
+    }
+    return result;
+}
+
+/** Number of elements below which sums are accumulated directly (in the accumulators' lanes) */
+static constexpr offset_type PairwiseBlockSize = 512;
+
+/** Pairwise (cascade) summation: the rounding error grows with log(n) instead of n */
+template<typename T, class Op>
+inline T pairwiseSum(const T* src, offset_type n) noexcept
+{
+    if (n <= PairwiseBlockSize) {
+        return reduce<T, Op>(IsVectorized<T>{}, src, n, T(0));
+    }
+    const offset_type half = n / 2;
+    return pairwiseSum<T, Op>(src, half) + pairwiseSum<T, Op>(src + half, n - half);
+}
+} // namespace detail
+
+/** @returns the sum of the `n` elements (pairwise summation) */
+template<typename T>
+inline T sum(const T* src, offset_type n) noexcept { return detail::pairwiseSum<T, detail::SumOp>(src, n); }
+
+/** @returns the sum of the squares of the `n` elements (pairwise summation) */
+template<typename T>
+inline T sumOfSquares(const T* src, offset_type n) noexcept { return detail::pairwiseSum<T, detail::SumOfSquaresOp>(src, n); }
+
+/** @returns the smallest of the `n` elements (n > 0), NaN if any element is NaN */
+template<typename T>
+inline T minimum(const T* src, offset_type n) noexcept { return detail::reduce<T, detail::MinOp>(detail::IsVectorized<T>{}, src, n, src[0]); }
+
+/** @returns the largest of the `n` elements (n > 0), NaN if any element is NaN */
+template<typename T>
+inline T maximum(const T* src, offset_type n) noexcept { return detail::reduce<T, detail::MaxOp>(detail::IsVectorized<T>{}, src, n, src[0]); }
+
+/** @returns the largest absolute value of the `n` elements, NaN if any element is NaN */
+template<typename T>
+inline T peak(const T* src, offset_type n) noexcept { return detail::reduce<T, detail::PeakOp>(detail::IsVectorized<T>{}, src, n, T(0)); }
+
+namespace detail
+{
+/** Vectorized (de-)interleaving of as many frames as possible; @returns the number of frames processed */
+template<typename T>
+inline offset_type deinterleaveFrames(T* const*, const T*, int, offset_type, offset_type) noexcept { return 0; }
+
+template<typename T>
+inline offset_type interleaveFrames(T*, const T* const*, int, offset_type, offset_type) noexcept { return 0; }
+
+#if defined(SLB_SIMD_INTERLEAVE)
+inline offset_type deinterleaveFrames(float* const* dst, const float* src, int numChannels, offset_type numFrames,
+                                      offset_type rowOffset) noexcept
+{
+    offset_type i = 0;
+    if (numChannels == 2) {
+        for (; i + 4 <= numFrames; i += 4) {
+            SimdInterleave::deinterleave2(src + 2*i, dst[0] + rowOffset + i, dst[1] + rowOffset + i);
+        }
+    } else if (numChannels >= 4) {
+        // groups of 4 channels; the last group overlaps the previous one if the channel count is not a multiple of 4
+        for (; i + 4 <= numFrames; i += 4) {
+            for (int c = 0; c < numChannels; c += 4) {
+                const int first = (c + 4 <= numChannels) ? c : numChannels - 4;
+                float* const* rows = dst + first;
+                const offset_type j = rowOffset + i;
+                SimdInterleave::deinterleave4(src + i*numChannels + first, numChannels, rows[0] + j, rows[1] + j, rows[2] + j, rows[3] + j);
+            }
+        }
+    }
+    return i;
+}
+
+inline offset_type interleaveFrames(float* dst, const float* const* src, int numChannels, offset_type numFrames,
+                                    offset_type rowOffset) noexcept
+{
+    offset_type i = 0;
+    if (numChannels == 2) {
+        for (; i + 4 <= numFrames; i += 4) {
+            SimdInterleave::interleave2(src[0] + rowOffset + i, src[1] + rowOffset + i, dst + 2*i);
+        }
+    } else if (numChannels >= 4) {
+        for (; i + 4 <= numFrames; i += 4) {
+            for (int c = 0; c < numChannels; c += 4) {
+                const int first = (c + 4 <= numChannels) ? c : numChannels - 4;
+                const float* const* rows = src + first;
+                const offset_type j = rowOffset + i;
+                SimdInterleave::interleave4(rows[0] + j, rows[1] + j, rows[2] + j, rows[3] + j, dst + i*numChannels + first, numChannels);
+            }
+        }
+    }
+    return i;
+}
+#endif
+} // namespace detail
+
+/**
+ * dst[c][rowOffset + i] = src[i * numChannels + c]: splits `numFrames` interleaved frames into `numChannels` rows,
+ * starting at index `rowOffset` of the rows
+ */
+template<typename T>
+inline void deinterleave(T* const* dst, const T* src, int numChannels, offset_type numFrames, offset_type rowOffset = 0) noexcept
+{
+    for (offset_type i = detail::deinterleaveFrames(dst, src, numChannels, numFrames, rowOffset); i < numFrames; ++i) {
+        for (int c = 0; c < numChannels; ++c) {
+            dst[c][rowOffset + i] = src[i*numChannels + c];
+        }
+    }
+}
+
+/**
+ * dst[i * numChannels + c] = src[c][rowOffset + i]: merges `numChannels` rows, starting at index `rowOffset` of the
+ * rows, into `numFrames` interleaved frames
+ */
+template<typename T>
+inline void interleave(T* dst, const T* const* src, int numChannels, offset_type numFrames, offset_type rowOffset = 0) noexcept
+{
+    for (offset_type i = detail::interleaveFrames(dst, src, numChannels, numFrames, rowOffset); i < numFrames; ++i) {
+        for (int c = 0; c < numChannels; ++c) {
+            dst[i*numChannels + c] = src[c][rowOffset + i];
+        }
+    }
+}
+
+} // namespace SimdKernels
+} // namespace slb
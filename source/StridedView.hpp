@@ -0,0 +1,193 @@
+//
+//  ╦ ╦┬ ┬┌─┐┌─┐┬─┐  ╔╗ ┬ ┬┌─┐┌─┐┌─┐┬─┐
+//  ╠═╣└┬┘├─┘├┤ ├┬┘  ╠╩╗│ │├┤ ├┤ ├┤ ├┬┘
+//  ╩ ╩ ┴ ┴  └─┘┴└─  ╚═╝└─┘└  └  └─┘┴└─
+//
+//  © 2023 Lorenz Bucher - all rights reserved
+//  https://github.com/Sidelobe/HyperBuffer
+
+#pragma once
+
+#include <array>
+#include <type_traits>
+
+#include "TemplateUtils.hpp"
+#include "IntArrayOperations.hpp"
+
+namespace slb
+{
+
+/**
+ *  Pointer-free view to N-dimensional data: stores only the address of the first element, plus the extent and the
+ *  stride (distance in elements between two consecutive indices) of every dimension. Element addresses are computed
+ *  arithmetically, which makes creating and copying a view free (no allocation, no pointer array to hook up).
+ *
+ *  Like a raw pointer, the view does not own the data and does not propagate its own const-ness to it: use
+ *  StridedView<const T, N> for read-only access.
+ *
+ *  - Template parameters: T=data type (e.g. float, const float),  N=dimension (e.g. 3)
+ */
+template<typename T, int N>
+class StridedView
+{
+    static_assert(N > 0, "StridedView needs at least one dimension");
+
+public:
+    using size_type = int;
+
+    /** Constructor that takes the address of the first element, the extents and the strides of the dimensions */
+    StridedView(T* data, const std::array<int, N>& dimensionExtents, const std::array<offset_type, N>& strides) noexcept :
+        m_data(data),
+        m_dimensionExtents(dimensionExtents),
+        m_strides(strides)
+    {
+    }
+
+    /** Constructor that takes the address of the first element and the geometry of (contiguous) HyperBuffer data */
+    template<class Geometry>
+    StridedView(T* data, const Geometry& bufferGeometry) noexcept :
+        StridedView(data, bufferGeometry.getDimensionExtents(), bufferGeometry.getStrides())
+    {
+    }
+
+    /** Conversion to a read-only view */
+    template<typename U = T, std::enable_if_t<!std::is_const<U>::value, int> = 0>
+    operator StridedView<const T, N>() const noexcept { return { m_data, m_dimensionExtents, m_strides }; }
+
+    // MARK: dimension extents & strides
+    int size(int i) const { ASSERT(i < N); return m_dimensionExtents[i]; }
+    const std::array<int, N>& sizes() const noexcept { return m_dimensionExtents; }
+    offset_type stride(int i) const { ASSERT(i < N); return m_strides[i]; }
+    const std::array<offset_type, N>& strides() const noexcept { return m_strides; }
+
+    /** @return the address of the first element */
+    T* data() const noexcept { return m_data; }
+
+    /** @return true if the elements are laid out back-to-back in memory, without any gaps */
+    bool isContiguous() const noexcept
+    {
+        offset_type expectedStride = 1;
+        for (int i = N-1; i >= 0; --i) {
+            if (m_dimensionExtents[i] > 1 && m_strides[i] != expectedStride) {
+                return false;
+            }
+            expectedStride *= m_dimensionExtents[i];
+        }
+        return true;
+    }
+
+    // MARK: operator[] -- returns a N-1 view for N>1, a reference to the data for N=1
+    template<int M=N, std::enable_if_t<(M>1), int> = 0>
+    StridedView<T, N-1> operator[] (size_type i) const noexcept
+    {
+        return { m_data + i * m_strides[0],
+                 StdArrayOperations::shaveOffFirstElement(m_dimensionExtents),
+                 StdArrayOperations::shaveOffFirstElement(m_strides) };
+    }
+
+    template<int M=N, std::enable_if_t<(M==1), int> = 0>
+    T& operator[] (size_type i) const noexcept { return m_data[i * m_strides[0]]; }
+
+    // MARK: at(...) -- bounds-checked access to an element (exactly N indices)
+    template<typename... I, std::enable_if_t<(sizeof...(I)==N), int> = 0>
+    T& at(I... i) const
+    {
+        return m_data[getOffset(i...)];
+    }
+
+    // MARK: slicing -- zero-copy views to a part of the data
+    /**
+     * @return a view restricted to `length` indices along dimension `dim`, starting at index `start` and advancing
+     * by `step` indices (a negative step traverses the dimension backwards). The dimensionality is unchanged.
+     * Example: `view.slice(1, 128, 128)` selects samples 128-255 of every channel of a [channel][sample] view.
+     */
+    StridedView slice(int dim, int start, int length, int step = 1) const
+    {
+        ASSERT(dim >= 0 && dim < N, "Invalid dimension");
+        ASSERT(step != 0 && length >= 0, "Invalid slice");
+        const offset_type last = start + static_cast<offset_type>(length - 1) * step;
+        ASSERT(start >= 0 && start <= m_dimensionExtents[dim], "Slice out of range");
+        ASSERT(length == 0 || (start < m_dimensionExtents[dim] && last >= 0 && last < m_dimensionExtents[dim]),
+               "Slice out of range");
+        StridedView sliced(*this);
+        if (length > 0) { // an empty slice keeps pointing to valid data
+            sliced.m_data += static_cast<offset_type>(start) * m_strides[dim];
+        }
+        sliced.m_dimensionExtents[dim] = length;
+        sliced.m_strides[dim] *= step;
+        return sliced;
+    }
+    
+    /**
+     * @return a N-1 view where the index along dimension `dim` is fixed to `index`, e.g. `view.select(1, 0)` of a
+     * [channel][sample] view is a view to the first sample of every channel. `select(0, i)` is equivalent to `[i]`.
+     */
+    template<int M=N, std::enable_if_t<(M>1), int> = 0>
+    StridedView<T, N-1> select(int dim, int index) const
+    {
+        ASSERT(dim >= 0 && dim < N, "Invalid dimension");
+        ASSERT(index >= 0 && index < m_dimensionExtents[dim], "Index out of range");
+        return { m_data + static_cast<offset_type>(index) * m_strides[dim],
+                 StdArrayOperations::removeElement(m_dimensionExtents, dim),
+                 StdArrayOperations::removeElement(m_strides, dim) };
+    }
+
+    // MARK: broadcasting -- zero-copy views with a larger geometry
+    /**
+     * @return a read-only view with the given extents, in which dimension i of this view is mapped to dimension
+     * `dims[i]` (in increasing order). All other dimensions - and dimensions of extent 1 - repeat the data: their
+     * stride is 0. Example: a [channel] vector of gains broadcast to a [channel][sample] geometry:
+     * `gains.broadcast<2>({ numChannels, numSamples }, { 0 })`.
+     */
+    template<std::size_t M>
+    StridedView<const T, static_cast<int>(M)> broadcast(const std::array<int, M>& extents, const std::array<int, N>& dims) const
+    {
+        std::array<offset_type, M> strides {};
+        int previousDim = -1;
+        for (int i = 0; i < N; ++i) {
+            const int dim = dims[static_cast<std::size_t>(i)];
+            ASSERT(dim > previousDim && dim < static_cast<int>(M), "Invalid mapping of dimensions");
+            const int extent = extents[static_cast<std::size_t>(dim)];
+            ASSERT(m_dimensionExtents[i] == extent || m_dimensionExtents[i] == 1, "Extents cannot be broadcast");
+            strides[static_cast<std::size_t>(dim)] = (m_dimensionExtents[i] == 1) ? 0 : m_strides[i];
+            previousDim = dim;
+        }
+        return { m_data, extents, strides };
+    }
+
+    /**
+     * @return a read-only view with the given extents, following the broadcasting rules of NumPy: the dimensions of
+     * this view are mapped to the last N dimensions, e.g. a [bin] window broadcast to a [frame][bin] geometry.
+     */
+    template<std::size_t M>
+    StridedView<const T, static_cast<int>(M)> broadcast(const std::array<int, M>& extents) const
+    {
+        static_assert(static_cast<int>(M) >= N, "Cannot broadcast to fewer dimensions");
+        std::array<int, N> dims;
+        for (int i = 0; i < N; ++i) {
+            dims[static_cast<std::size_t>(i)] = static_cast<int>(M) - N + i;
+        }
+        return broadcast(extents, dims);
+    }
+
+private:
+    /** @return the offset (in elements) of the element at the given indices, relative to the first element */
+    template<typename... I>
+    offset_type getOffset(I... i) const
+    {
+        const std::array<int, N> indices { static_cast<int>(i)... };
+        offset_type offset = 0;
+        for (int dim = 0; dim < N; ++dim) {
+            ASSERT(indices[dim] >= 0 && indices[dim] < m_dimensionExtents[dim], "Index out of range");
+            offset += static_cast<offset_type>(indices[dim]) * m_strides[dim];
+        }
+        return offset;
+    }
+
+private:
+    T* m_data;
+    std::array<int, N> m_dimensionExtents;
+    std::array<offset_type, N> m_strides;
+};
+
+} // namespace slb
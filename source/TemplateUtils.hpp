@@ -9,6 +9,7 @@
 #pragma once
 
 #include <algorithm>
+#include <cstddef>
 #include <cstdlib>
 #include <sstream>
 #include <type_traits>
@@ -44,6 +45,29 @@ static constexpr std::add_const_t<T>& as_const(T& t) noexcept { return t; }
 namespace slb
 {
 
+// MARK: - Offset type
+/**
+ * Signed type used for element counts, strides and offsets in the (flat) data and pointer arrays, i.e. for all the
+ * quantities that grow with the product of the extents. The extents of the individual dimensions are always `int`.
+ * Defaults to std::ptrdiff_t (64-bit on 64-bit platforms), can be overridden by defining SLB_OFFSET_TYPE.
+ */
+#ifndef SLB_OFFSET_TYPE
+    #define SLB_OFFSET_TYPE std::ptrdiff_t
+#endif
+using offset_type = SLB_OFFSET_TYPE;
+static_assert(std::is_integral<offset_type>::value && std::is_signed<offset_type>::value, "offset_type must be a signed integer");
+static_assert(sizeof(offset_type) >= sizeof(int), "offset_type must be at least as large as int");
+
+// MARK: - Cache line size
+/**
+ * Distance (in bytes) that keeps two objects from sharing a cache line, used to pad data shared between threads
+ * (std::hardware_destructive_interference_size is C++17). Can be overridden by defining SLB_CACHE_LINE_SIZE.
+ */
+#ifndef SLB_CACHE_LINE_SIZE
+    #define SLB_CACHE_LINE_SIZE 64
+#endif
+static constexpr std::size_t CacheLineSize = SLB_CACHE_LINE_SIZE;
+
 // MARK: - Assertion handling
 namespace Assertions
 {
@@ -0,0 +1,251 @@
+//
+//  ╦ ╦┬ ┬┌─┐┌─┐┬─┐  ╔╗ ┬ ┬┌─┐┌─┐┌─┐┬─┐
+//  ╠═╣└┬┘├─┘├┤ ├┬┘  ╠╩╗│ │├┤ ├┤ ├┤ ├┬┘
+//  ╩ ╩ ┴ ┴  └─┘┴└─  ╚═╝└─┘└  └  └─┘┴└─
+//
+//  © 2023 Lorenz Bucher - all rights reserved
+//  https://github.com/Sidelobe/HyperBuffer
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <limits>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "HyperBuffer.hpp"
+
+namespace slb
+{
+
+/**
+ *  Pool of worker threads that execute index ranges of a loop in parallel: `parallelFor(numItems, function)` calls
+ *  `function(i)` for every i in [0, numItems). The calling thread takes part in the work and returns once all items
+ *  have been processed.
+ *
+ *  Scheduling:
+ *  - Static: every thread processes an equal share of consecutive items (lowest overhead, for items of equal cost)
+ *  - WorkStealing: every thread starts on its equal share, taking `grainSize` items at a time; threads that are done
+ *    take the remaining items of the other threads' shares (for items of varying cost)
+ *
+ *  - Guarantees: the threads are created during construction. A call to parallelFor() does not allocate.
+ *  - Threading: calls from several threads are executed one after the other. The function must not throw and must not
+ *    call parallelFor() on the same pool.
+ */
+class ThreadPool
+{
+public:
+    enum class Schedule
+    {
+        Static,
+        WorkStealing
+    };
+
+    /** @returns the number of hardware threads (at least 1) */
+    static int getHardwareConcurrency() noexcept { return std::max(1, static_cast<int>(std::thread::hardware_concurrency())); }
+
+    /** Constructor that takes the number of threads that share the work, including the calling thread */
+    explicit ThreadPool(int numThreads = getHardwareConcurrency()) :
+        m_partitions(static_cast<std::size_t>(std::max(numThreads, 1)))
+    {
+        ASSERT(numThreads > 0, "Number of threads must be positive");
+        m_workers.reserve(static_cast<std::size_t>(numThreads - 1));
+        for (int thread = 1; thread < numThreads; ++thread) {
+            m_workers.emplace_back([this, thread]() { workerLoop(thread); });
+        }
+    }
+
+    ~ThreadPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stop = true;
+        }
+        m_wakeUp.notify_all();
+        for (auto& worker : m_workers) {
+            worker.join();
+        }
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    int getNumThreads() const noexcept { return static_cast<int>(m_partitions.size()); }
+
+    /** Calls `function(i)` for every i in [0, numItems), distributed across the threads of the pool */
+    template<class Function>
+    void parallelFor(int numItems, Function&& function, Schedule schedule = Schedule::Static, int grainSize = 1)
+    {
+        ASSERT(grainSize > 0, "Grain size must be positive");
+        using F = std::remove_reference_t<Function>;
+        void* erasedFunction = const_cast<void*>(static_cast<const void*>(&function));
+        if (numItems <= 0) {
+            return;
+        }
+        if (m_workers.empty() || numItems <= grainSize) {
+            invoke<F>(erasedFunction, 0, numItems);
+            return;
+        }
+
+        std::lock_guard<std::mutex> jobLock(m_jobMutex);
+        m_job.invoke = &invoke<F>;
+        m_job.function = erasedFunction;
+        m_job.schedule = schedule;
+        m_job.grainSize = grainSize;
+        const int numThreads = getNumThreads();
+        for (int thread = 0; thread < numThreads; ++thread) {
+            Partition& partition = m_partitions[static_cast<std::size_t>(thread)];
+            partition.next.store(static_cast<int>(static_cast<long long>(numItems) * thread / numThreads), std::memory_order_relaxed);
+            partition.end = static_cast<int>(static_cast<long long>(numItems) * (thread + 1) / numThreads);
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_numBusyWorkers = static_cast<int>(m_workers.size());
+            ++m_generation;
+        }
+        m_wakeUp.notify_all();
+
+        work(0);
+
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_done.wait(lock, [this]() { return m_numBusyWorkers == 0; });
+    }
+
+private:
+    /** Type-erased loop body: calls the function for a range of items */
+    template<class F>
+    static void invoke(void* function, int begin, int end)
+    {
+        F& f = *static_cast<F*>(function);
+        for (int i = begin; i < end; ++i) {
+            f(i);
+        }
+    }
+
+    /** Processes the thread's own share and - for work-stealing - the remaining items of the other threads' shares */
+    void work(int thread)
+    {
+        Partition& own = m_partitions[static_cast<std::size_t>(thread)];
+        if (m_job.schedule == Schedule::Static) {
+            m_job.invoke(m_job.function, own.next.load(std::memory_order_relaxed), own.end);
+            return;
+        }
+        const int numThreads = getNumThreads();
+        for (int i = 0; i < numThreads; ++i) {
+            Partition& partition = m_partitions[static_cast<std::size_t>((thread + i) % numThreads)];
+            while (true) {
+                // avoid overflow of the counter by threads that keep stealing
+                if (partition.next.load(std::memory_order_relaxed) >= partition.end) {
+                    break;
+                }
+                const int begin = partition.next.fetch_add(m_job.grainSize, std::memory_order_relaxed);
+                if (begin >= partition.end) {
+                    break;
+                }
+                m_job.invoke(m_job.function, begin, begin + std::min(m_job.grainSize, partition.end - begin));
+            }
+        }
+    }
+
+    void workerLoop(int thread)
+    {
+        unsigned generation = 0;
+        while (true) {
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_wakeUp.wait(lock, [this, generation]() { return m_stop || m_generation != generation; });
+                if (m_stop) {
+                    return;
+                }
+                generation = m_generation;
+            }
+            work(thread);
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                if (--m_numBusyWorkers == 0) {
+                    m_done.notify_one();
+                }
+            }
+        }
+    }
+
+private:
+    struct Job
+    {
+        void (*invoke)(void*, int, int) = nullptr;
+        void* function = nullptr;
+        Schedule schedule = Schedule::Static;
+        int grainSize = 1;
+    };
+
+    /** Range of items of one thread, on its own cache line: [next, end) remain to be processed */
+    struct alignas(CacheLineSize) Partition
+    {
+        std::atomic<int> next { 0 };
+        int end = 0;
+    };
+
+    Job m_job;
+    std::vector<Partition, AlignedAllocator<Partition>> m_partitions;
+    std::vector<std::thread> m_workers;
+
+    std::mutex m_jobMutex;              // serializes calls of parallelFor()
+    std::mutex m_mutex;                 // guards the members below
+    std::condition_variable m_wakeUp;
+    std::condition_variable m_done;
+    unsigned m_generation = 0;
+    int m_numBusyWorkers = 0;
+    bool m_stop = false;
+};
+
+namespace detail
+{
+/** @returns the sub-view at the given flat index across the D leading dimensions */
+template<typename T, int N, class StoragePolicy>
+decltype(auto) getLeadingSubView(const HyperBuffer<T, N, StoragePolicy>& buffer, std::integral_constant<int, 1>, int index)
+{
+    return buffer.subView(index);
+}
+
+template<typename T, int N, class StoragePolicy, int D>
+decltype(auto) getLeadingSubView(const HyperBuffer<T, N, StoragePolicy>& buffer, std::integral_constant<int, D>, int index)
+{
+    int numInnerItems = 1;
+    for (int dim = 1; dim < D; ++dim) {
+        numInnerItems *= buffer.size(dim);
+    }
+    return getLeadingSubView(buffer.subView(index / numInnerItems), std::integral_constant<int, D-1>{}, index % numInnerItems);
+}
+} // namespace detail
+
+/**
+ * Calls `function(subView, index)` in parallel for every index of the outermost dimension - or, with NumDims > 1, for
+ * every (flat) index across the NumDims leading dimensions - with the sub-view of N-NumDims dimensions at that index,
+ * e.g. for every channel of a [channel][sample] buffer:
+ *
+ *     parallelForEach(pool, buffer, [](auto channel, int ch) { process(channel); });
+ *
+ * The sub-views borrow the buffer's pointers (@see HyperBuffer::subView), no allocation takes place.
+ */
+template<int NumDims = 1, typename T, int N, class StoragePolicy, class Function>
+void parallelForEach(ThreadPool& pool, HyperBuffer<T, N, StoragePolicy>& buffer, Function&& function,
+                     ThreadPool::Schedule schedule = ThreadPool::Schedule::Static, int grainSize = 1)
+{
+    static_assert(NumDims > 0 && NumDims < N, "Sub-views must have at least one dimension");
+    offset_type numItems = 1;
+    for (int dim = 0; dim < NumDims; ++dim) {
+        numItems *= buffer.size(dim);
+    }
+    ASSERT(numItems <= std::numeric_limits<int>::max(), "Too many items");
+
+    pool.parallelFor(static_cast<int>(numItems), [&buffer, &function](int index) {
+        function(detail::getLeadingSubView(buffer, std::integral_constant<int, NumDims>{}, index), index);
+    }, schedule, grainSize);
+}
+
+} // namespace slb
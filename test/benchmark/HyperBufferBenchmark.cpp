@@ -0,0 +1,291 @@
+//
+//  ╦ ╦┬ ┬┌─┐┌─┐┬─┐  ╔╗ ┬ ┬┌─┐┌─┐┌─┐┬─┐
+//  ╠═╣└┬┘├─┘├┤ ├┬┘  ╠╩╗│ │├┤ ├┤ ├┤ ├┬┘
+//  ╩ ╩ ┴ ┴  └─┘┴└─  ╚═╝└─┘└  └  └─┘┴└─
+//
+//  © 2023 Lorenz Bucher - all rights reserved
+//  https://github.com/Sidelobe/HyperBuffer
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Micro-benchmarks for the construction, access and copy paths of HyperBuffer, compared against raw pointer baselines.
+// Every benchmark reports the time per operation (best of several runs), the throughput and the number of dynamic
+// memory allocations per operation. Run a Release build: `HyperBufferBenchmark [filter]`.
+// ---------------------------------------------------------------------------------------------------------------------
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <numeric>
+#include <string>
+#include <vector>
+
+#include "HyperBuffer.hpp"
+
+// MARK: - Allocation counting
+namespace
+{
+std::atomic<long> g_numAllocations { 0 };
+}
+
+void* operator new(std::size_t numBytes)
+{
+    g_numAllocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* memory = std::malloc(numBytes == 0 ? 1 : numBytes)) {
+        return memory;
+    }
+    throw std::bad_alloc();
+}
+void operator delete(void* memory) noexcept { std::free(memory); }
+void operator delete(void* memory, std::size_t) noexcept { std::free(memory); }
+void* operator new[](std::size_t numBytes) { return operator new(numBytes); }
+void operator delete[](void* memory) noexcept { std::free(memory); }
+void operator delete[](void* memory, std::size_t) noexcept { std::free(memory); }
+
+using namespace slb;
+
+namespace
+{
+// MARK: - Harness
+/** Prevents the compiler from optimizing away a value (or the computation that produced it) */
+template<typename T>
+inline void doNotOptimize(const T& value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static volatile const void* sink;
+    sink = &value;
+#endif
+}
+
+const char* g_filter = nullptr;
+
+/**
+ * Runs `op` `iterations` times per run and prints the best run.
+ * @param bytesPerOp number of bytes processed per operation (0: no throughput is reported)
+ */
+template<class Op>
+void benchmark(const char* name, int iterations, double bytesPerOp, Op&& op)
+{
+    if (g_filter != nullptr && std::strstr(name, g_filter) == nullptr) {
+        return;
+    }
+    constexpr int numRuns = 7;
+    op(); // warm-up
+    double bestNs = 1e300;
+    long allocations = 0;
+    for (int run = 0; run < numRuns; ++run) {
+        const long allocationsBefore = g_numAllocations.load();
+        const auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < iterations; ++i) {
+            op();
+        }
+        const auto end = std::chrono::steady_clock::now();
+        allocations = g_numAllocations.load() - allocationsBefore;
+        const double ns = std::chrono::duration<double, std::nano>(end - start).count() / iterations;
+        bestNs = std::min(bestNs, ns);
+    }
+    const double allocationsPerOp = static_cast<double>(allocations) / iterations;
+    if (bytesPerOp > 0) {
+        std::printf("%-48s %12.2f ns/op %10.2f GB/s %8.2f allocs/op\n", name, bestNs, bytesPerOp / bestNs, allocationsPerOp);
+    } else {
+        std::printf("%-48s %12.2f ns/op %10s      %8.2f allocs/op\n", name, bestNs, "-", allocationsPerOp);
+    }
+}
+
+void printSection(const char* title)
+{
+    if (g_filter == nullptr) {
+        std::printf("\n--- %s\n", title);
+    }
+}
+
+// MARK: - Benchmarks
+void benchmarkConstruction()
+{
+    printSection("Construction");
+    benchmark("construct Owning<float,2>(2,512)", 20000, 0, [] {
+        HyperBuffer<float, 2> buffer(2, 512); doNotOptimize(buffer.data());
+    });
+    benchmark("construct Owning<float,3>(8,16,512)", 5000, 0, [] {
+        HyperBuffer<float, 3> buffer(8, 16, 512); doNotOptimize(buffer.data());
+    });
+    benchmark("construct Owning<float,4>(4,8,16,64)", 5000, 0, [] {
+        HyperBuffer<float, 4> buffer(4, 8, 16, 64); doNotOptimize(buffer.data());
+    });
+    benchmark("construct Aligned<float,3,64>(8,16,500)", 5000, 0, [] {
+        HyperBufferAligned<float, 3, 64> buffer(8, 16, 500); doNotOptimize(buffer.data());
+    });
+    benchmark("construct SingleBlock<float,3>(8,16,512)", 5000, 0, [] {
+        HyperBufferSingleBlock<float, 3> buffer(8, 16, 512); doNotOptimize(buffer.data());
+    });
+    benchmark("construct Static<float,2,512>", 20000, 0, [] {
+        StaticHyperBuffer<float, 2, 512> buffer; doNotOptimize(buffer.data());
+    });
+    alignas(64) static unsigned char arena[64*1024];
+    benchmark("construct Owning<float,3>(8,16,64) from arena", 20000, 0, [] {
+        MonotonicBufferResource resource(arena, sizeof(arena), MemoryResources::getNullResource());
+        HyperBuffer<float, 3> buffer(&resource, 8, 16, 64); doNotOptimize(buffer.data());
+    });
+
+    static std::vector<float> flat(8*16*512);
+    benchmark("construct View<float,3>(8,16,512)", 20000, 0, [] {
+        HyperBufferView<float, 3> view(flat.data(), 8, 16, 512); doNotOptimize(view.data());
+    });
+    static std::vector<float*> rows(8*16);
+    static std::vector<float**> planes(8);
+    for (int i = 0; i < 8; ++i) {
+        planes[i] = &rows[i*16];
+        for (int j = 0; j < 16; ++j) {
+            rows[i*16 + j] = &flat[(i*16 + j) * 512];
+        }
+    }
+    benchmark("construct ViewNC<float,3>(8,16,512)", 20000, 0, [] {
+        HyperBufferViewNC<float, 3> view(planes.data(), 8, 16, 512); doNotOptimize(view.data());
+    });
+    benchmark("construct StridedView<float,3>(8,16,512)", 20000, 0, [] {
+        StridedView<float, 3> view(flat.data(), BufferGeometry<3>(8, 16, 512)); doNotOptimize(view);
+    });
+    benchmark("baseline: new float[] + new float*[] (8,16,512)", 5000, 0, [] {
+        float* data = new float[8*16*512]();
+        float** pointers = new float*[8*16 + 8];
+        doNotOptimize(data); doNotOptimize(pointers);
+        delete[] pointers;
+        delete[] data;
+    });
+}
+
+void benchmarkHookup()
+{
+    printSection("Pointer hookup");
+    static std::vector<float> data(64*64*32*16);
+    BufferGeometry<4> geometry(64, 64, 32, 16);
+    static std::vector<float*> pointers(geometry.getRequiredPointerArraySize());
+    char name[128];
+    std::snprintf(name, sizeof(name), "hookupPointerArrayToData (64,64,32,16): %lld ptrs", static_cast<long long>(geometry.getRequiredPointerArraySize()));
+    benchmark(name, 200, static_cast<double>(pointers.size() * sizeof(float*)), [&geometry] {
+        geometry.hookupPointerArrayToData(data.data(), pointers.data()); doNotOptimize(pointers.data());
+    });
+}
+
+void benchmarkAccess()
+{
+    printSection("Element access (sum over 8x16x512 floats)");
+    constexpr int A = 8, B = 16, C = 512;
+    constexpr double bytes = A * B * C * sizeof(float);
+    static HyperBuffer<float, 3> buffer(A, B, C);
+    std::iota(&buffer[0][0][0], &buffer[0][0][0] + A*B*C, 0.f);
+    static StridedView<const float, 3> strided = std::as_const(buffer).stridedView();
+
+    benchmark("operator[] chaining", 200, bytes, [] {
+        float sum = 0;
+        for (int i = 0; i < A; ++i) for (int j = 0; j < B; ++j) for (int k = 0; k < C; ++k) { sum += buffer[i][j][k]; }
+        doNotOptimize(sum);
+    });
+    benchmark("at(i, j, k)", 200, bytes, [] {
+        float sum = 0;
+        for (int i = 0; i < A; ++i) for (int j = 0; j < B; ++j) for (int k = 0; k < C; ++k) { sum += buffer.at(i, j, k); }
+        doNotOptimize(sum);
+    });
+    benchmark("StridedView at(i, j, k)", 200, bytes, [] {
+        float sum = 0;
+        for (int i = 0; i < A; ++i) for (int j = 0; j < B; ++j) for (int k = 0; k < C; ++k) { sum += strided.at(i, j, k); }
+        doNotOptimize(sum);
+    });
+    benchmark("baseline: raw T*** [i][j][k]", 200, bytes, [] {
+        float*** raw = buffer.data();
+        float sum = 0;
+        for (int i = 0; i < A; ++i) for (int j = 0; j < B; ++j) for (int k = 0; k < C; ++k) { sum += raw[i][j][k]; }
+        doNotOptimize(sum);
+    });
+    benchmark("baseline: flat T* [(i*B + j)*C + k]", 200, bytes, [] {
+        const float* flat = &buffer[0][0][0];
+        float sum = 0;
+        for (int i = 0; i < A; ++i) for (int j = 0; j < B; ++j) for (int k = 0; k < C; ++k) { sum += flat[(i*B + j)*C + k]; }
+        doNotOptimize(sum);
+    });
+
+    printSection("Sub-views");
+    benchmark("subView(i) [Owning<float,3>]", 100000, 0, [] {
+        auto subView = buffer.subView(3); doNotOptimize(subView.data());
+    });
+    benchmark("subView(i, j) [Owning<float,3>]", 100000, 0, [] {
+        auto subView = buffer.subView(3, 5); doNotOptimize(subView.data());
+    });
+    benchmark("slice(2, 128, 128) [Owning<float,3>]", 100000, 0, [] {
+        auto slice = buffer.slice(2, 128, 128); doNotOptimize(slice);
+    });
+}
+
+void benchmarkCopyMove()
+{
+    printSection("Copy & move (8x16x512 floats)");
+    constexpr double bytes = 8 * 16 * 512 * sizeof(float);
+    static HyperBuffer<float, 3> source(8, 16, 512);
+    static HyperBuffer<float, 3> target(8, 16, 512);
+    benchmark("copy-construct Owning<float,3>", 2000, bytes, [] {
+        HyperBuffer<float, 3> copy(source); doNotOptimize(copy.data());
+    });
+    benchmark("copy-assign Owning<float,3> (same size)", 2000, bytes, [] {
+        target = source; doNotOptimize(target.data());
+    });
+    benchmark("move-construct Owning<float,3>", 100000, 0, [] {
+        HyperBuffer<float, 3> moved(std::move(target)); target = std::move(moved); doNotOptimize(target.data());
+    });
+    static HyperBufferSingleBlock<float, 3> sourceSingleBlock(8, 16, 512);
+    static HyperBufferSingleBlock<float, 3> targetSingleBlock(8, 16, 512);
+    benchmark("copy-assign SingleBlock<float,3> (same size)", 2000, bytes, [] {
+        targetSingleBlock = sourceSingleBlock; doNotOptimize(targetSingleBlock.data());
+    });
+    benchmark("baseline: memcpy", 2000, bytes, [] {
+        std::memcpy(&target[0][0][0], &source[0][0][0], static_cast<std::size_t>(bytes)); doNotOptimize(target.data());
+    });
+}
+
+void benchmarkBulk()
+{
+    printSection("Bulk operations (dst += src, 16x4096 floats)");
+    constexpr int A = 16, B = 4096;
+    constexpr double bytes = 3.0 * A * B * sizeof(float); // 2 reads, 1 write
+    static HyperBuffer<float, 2> dst(A, B);
+    static HyperBuffer<float, 2> src(A, B);
+    static HyperBufferAligned<float, 2, 64> dstPadded(A, B - 3);
+    static HyperBufferAligned<float, 2, 64> srcPadded(A, B - 3);
+    BufferOperations::fill(src, 0.001f);
+    BufferOperations::fill(srcPadded, 0.001f);
+
+    benchmark("BufferOperations::add (flat)", 500, bytes, [] {
+        BufferOperations::add(dst, src); doNotOptimize(dst.data());
+    });
+    benchmark("BufferOperations::add (padded rows)", 500, bytes, [] {
+        BufferOperations::add(dstPadded, srcPadded); doNotOptimize(dstPadded.data());
+    });
+    benchmark("scalar loop over operator[]", 500, bytes, [] {
+        for (int i = 0; i < A; ++i) for (int j = 0; j < B; ++j) { dst[i][j] += src[i][j]; }
+        doNotOptimize(dst.data());
+    });
+    benchmark("baseline: flat T* loop", 500, bytes, [] {
+        float* d = &dst[0][0];
+        const float* s = &src[0][0];
+        for (int i = 0; i < A * B; ++i) { d[i] += s[i]; }
+        doNotOptimize(dst.data());
+    });
+}
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    if (argc > 1) {
+        g_filter = argv[1];
+    }
+    benchmarkConstruction();
+    benchmarkHookup();
+    benchmarkAccess();
+    benchmarkCopyMove();
+    benchmarkBulk();
+    return 0;
+}
@@ -0,0 +1,104 @@
+//
+//  ╦ ╦┬ ┬┌─┐┌─┐┬─┐  ╔╗ ┬ ┬┌─┐┌─┐┌─┐┬─┐
+//  ╠═╣└┬┘├─┘├┤ ├┬┘  ╠╩╗│ │├┤ ├┤ ├┤ ├┬┘
+//  ╩ ╩ ┴ ┴  └─┘┴└─  ╚═╝└─┘└  └  └─┘┴└─
+//
+//  © 2023 Lorenz Bucher - all rights reserved
+//  https://github.com/Sidelobe/HyperBuffer
+
+#include "TestCommon.hpp"
+#include "MemorySentinel.hpp"
+
+#include <functional>
+#include <numeric>
+#include <vector>
+
+#include "Algorithms.hpp"
+
+using namespace slb;
+
+namespace
+{
+/** Runs all algorithms in the given execution mode on buffers with the extents [3][1001] */
+template<class Mode, class Buffer, class OtherBuffer>
+void testAlgorithms(const Mode& mode, Buffer& buffer, OtherBuffer& other)
+{
+    std::iota(buffer.elements().begin(), buffer.elements().end(), 0.0);
+    Algorithms::fill(mode, other, 2.0);
+    REQUIRE(other[2][1000] == 2.0);
+
+    Algorithms::transform(mode, other, buffer, [](double x) { return x * 0.5; });
+    REQUIRE(other[0][0] == 0.0);
+    REQUIRE(other[2][1000] == 1501.0);
+    Algorithms::transform(mode, other, buffer, other, [](double x, double y) { return x - y; });
+    REQUIRE(other[1][999] == 1000.0);
+
+    int count = 0;
+    Algorithms::forEach(Execution::Sequential{}, std::as_const(buffer), [&count](double) { ++count; });
+    REQUIRE(count == 3003);
+    Algorithms::forEach(mode, buffer, [](double& x) { x += 1.0; });
+    REQUIRE(buffer[2][1000] == 3003.0);
+
+    const double sum = 3003.0 * 3004.0 / 2.0;
+    REQUIRE(Algorithms::reduce(mode, buffer, 0.0, std::plus<>{}) == sum);
+    REQUIRE(Algorithms::reduce(mode, buffer, 10.0, [](double a, double b) { return std::max(a, b); }) == 3003.0);
+    REQUIRE(Algorithms::reduce(mode, buffer, 10000.0, [](double a, double b) { return std::min(a, b); }) == 1.0);
+    REQUIRE(Algorithms::transformReduce(mode, buffer, 0.0, std::plus<>{}, [](double x) { return x * x; }) == 3003.0 * 3004.0 * 6007.0 / 6.0);
+    REQUIRE(Algorithms::transformReduce(mode, buffer, other, 1.0, std::plus<>{}, std::minus<>{}) == 1.0 + sum - 0.5 * (sum - 3003.0)); // other = 0.5 * (buffer - 1)
+
+    Algorithms::copy(mode, other, buffer);
+    REQUIRE(other[1][0] == 1002.0);
+    REQUIRE(Algorithms::reduce(mode, other, 0.0, std::plus<>{}) == sum);
+}
+} // namespace
+
+TEST_CASE("Algorithms Tests")
+{
+    ThreadPool pool(4);
+
+    SECTION("flat & padded") {
+        HyperBuffer<double, 2> flat(3, 1001);
+        HyperBufferAligned<double, 2, 64> padded(3, 1001);
+        testAlgorithms(Execution::Sequential{}, flat, padded);
+        testAlgorithms(Execution::Vectorized{}, flat, padded);
+        testAlgorithms(Execution::Parallel{ pool }, flat, padded);
+        HyperBuffer<double, 2> otherFlat(3, 1001);
+        testAlgorithms(Execution::Parallel{ pool }, flat, otherFlat);
+        testAlgorithms(Execution::Vectorized{}, otherFlat, flat);
+    }
+
+    SECTION("non-contiguous") {
+        std::vector<std::vector<double>> rows(3, std::vector<double>(1001));
+        double* rowPointers[3] = { rows[2].data(), rows[0].data(), rows[1].data() };
+        HyperBufferViewNC<double, 2> nonContiguous(rowPointers, 3, 1001);
+        HyperBuffer<double, 2> flat(3, 1001);
+        testAlgorithms(Execution::Sequential{}, nonContiguous, flat);
+        testAlgorithms(Execution::Parallel{ pool }, flat, nonContiguous);
+        REQUIRE(rows[2][0] == 1.0);
+    }
+
+    SECTION("parallel chunks start at cache line boundaries") {
+        std::vector<float> data(10007);
+        for (int offset = 0; offset < 3; ++offset) { // unaligned views
+            HyperBufferView<float, 1> view(data.data() + offset, 10000);
+            Algorithms::fill(Execution::Parallel{ pool }, view, 1.f);
+            REQUIRE(Algorithms::reduce(Execution::Parallel{ pool }, view, 0.f, std::plus<>{}) == 10000.f);
+            for (int chunk = 1; chunk < 4; ++chunk) {
+                const offset_type begin = Algorithms::detail::getChunkBegin(view.data(), 10000, chunk, 4);
+                REQUIRE(reinterpret_cast<std::uintptr_t>(view.data() + begin) % CacheLineSize == 0);
+            }
+        }
+        HyperBuffer<int, 1> tiny(3);
+        Algorithms::fill(Execution::Parallel{ pool }, tiny, 7);
+        REQUIRE(Algorithms::reduce(Execution::Parallel{ pool }, tiny, 1, std::plus<>{}) == 22);
+    }
+
+    SECTION("no dynamic memory allocation") {
+        HyperBuffer<float, 3> buffer(2, 3, 100);
+        HyperBuffer<float, 3> result(2, 3, 100);
+        ScopedMemorySentinel sentinel;
+        Algorithms::fill(Execution::Parallel{ pool }, buffer, 0.5f);
+        Algorithms::transform(Execution::Vectorized{}, result, buffer, [](float x) { return 2.f * x; });
+        REQUIRE(Algorithms::reduce(Execution::Parallel{ pool }, result, 0.f, std::plus<>{}) == 600.f);
+    }
+}
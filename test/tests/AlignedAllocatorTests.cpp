@@ -0,0 +1,53 @@
+//
+//  ╦ ╦┬ ┬┌─┐┌─┐┬─┐  ╔╗ ┬ ┬┌─┐┌─┐┌─┐┬─┐
+//  ╠═╣└┬┘├─┘├┤ ├┬┘  ╠╩╗│ │├┤ ├┤ ├┤ ├┬┘
+//  ╩ ╩ ┴ ┴  └─┘┴└─  ╚═╝└─┘└  └  └─┘┴└─
+//
+//  © 2023 Lorenz Bucher - all rights reserved
+//  https://github.com/Sidelobe/HyperBuffer
+
+#include "TestCommon.hpp"
+
+#include <cstdint>
+#include <vector>
+
+#ifdef SLB_AMALGATED_HEADER
+    #include "HyperBuffer.hpp"
+#else
+    #include "AlignedAllocator.hpp"
+#endif
+
+using namespace slb;
+
+TEST_CASE("AlignedMemory Tests")
+{
+    static_assert(AlignedMemory::isPowerOfTwo(64), "");
+    static_assert(!AlignedMemory::isPowerOfTwo(48), "");
+    static_assert(AlignedMemory::getAlignmentInElements<float>(64) == 16, "");
+    static_assert(AlignedMemory::getAlignmentInElements<double>(4) == 1, "");
+    static_assert(AlignedMemory::getAlignmentInElements<char[3]>(8) == 8, "");
+    
+    REQUIRE(AlignedMemory::roundUpToMultiple(5, 4) == 8);
+    REQUIRE(AlignedMemory::roundUpToMultiple(8, 4) == 8);
+    REQUIRE(AlignedMemory::roundUpToMultiple(0, 16) == 0);
+    
+    for (std::size_t alignment : { 1, 8, 32, 64, 128, 4096 }) {
+        void* memory = AlignedMemory::allocate(100, alignment);
+        REQUIRE(reinterpret_cast<std::uintptr_t>(memory) % alignment == 0);
+        AlignedMemory::deallocate(memory, alignment);
+    }
+    REQUIRE_THROWS(AlignedMemory::allocate(100, 48));
+}
+
+TEST_CASE("AlignedAllocator Tests")
+{
+    std::vector<float, AlignedAllocator<float, 64>> vector(33, 1.f);
+    REQUIRE(reinterpret_cast<std::uintptr_t>(vector.data()) % 64 == 0);
+    vector.resize(1000);
+    REQUIRE(reinterpret_cast<std::uintptr_t>(vector.data()) % 64 == 0);
+    REQUIRE(vector[32] == 1.f);
+    
+    // alignment is never lower than the natural one of the type
+    static_assert(AlignedAllocator<double, 1>::alignment == alignof(double), "");
+    REQUIRE(AlignedAllocator<float, 64>() == AlignedAllocator<int, 64>());
+}
@@ -93,13 +93,13 @@ TEST_CASE("BufferGeometry Tests")
         REQUIRE((float**)(pointers[1]) == &(pointers[6]));
         
         // Verify pointers to data (lowest-order) dimension
-        const int dataOffsetSubdim0 = bufferGeo.getDataArrayOffsetForHighestOrderSubDim(0);
+        const offset_type dataOffsetSubdim0 = bufferGeo.getDataArrayOffsetForHighestOrderSubDim(0);
         REQUIRE(pointers3D[0][0] == &data[dataOffsetSubdim0 + 0]);
         REQUIRE(pointers3D[0][1] == &data[dataOffsetSubdim0 + 2]);
         REQUIRE(pointers3D[0][2] == &data[dataOffsetSubdim0 + 4]);
         REQUIRE(pointers3D[0][3] == &data[dataOffsetSubdim0 + 6]);
 
-        const int dataOffsetSubdim1 = bufferGeo.getDataArrayOffsetForHighestOrderSubDim(1);
+        const offset_type dataOffsetSubdim1 = bufferGeo.getDataArrayOffsetForHighestOrderSubDim(1);
         REQUIRE(pointers3D[1][0] == &data[dataOffsetSubdim1 + 0]);
         REQUIRE(pointers3D[1][1] == &data[dataOffsetSubdim1 + 2]);
         REQUIRE(pointers3D[1][2] == &data[dataOffsetSubdim1 + 4]);
@@ -142,7 +142,7 @@ TEST_CASE("BufferGeometry Tests")
         REQUIRE((float**)(pointers[3]) == &(pointers[8]));
         
         // Verify pointers to data (lowest-order) dimension
-        const int dataOffsetSubdim0 = bufferGeo.getDataArrayOffsetForHighestOrderSubDim(0);
+        const offset_type dataOffsetSubdim0 = bufferGeo.getDataArrayOffsetForHighestOrderSubDim(0);
         REQUIRE(pointers4D[0][0][0] == &data[dataOffsetSubdim0 + 0]);
         REQUIRE(pointers4D[0][0][1] == &data[dataOffsetSubdim0 + 2]);
         REQUIRE(pointers4D[0][1][0] == &data[dataOffsetSubdim0 + 4]);
@@ -187,14 +187,14 @@ TEST_CASE("BufferGeometry Tests")
         REQUIRE(pointers5D[1][0][0][0] == pointers[38]);
 
         // Verify pointers to data (lowest-order) dimension   (sparse test)
-        const int dataOffsetSubdim0 = bufferGeo.getDataArrayOffsetForHighestOrderSubDim(0);
+        const offset_type dataOffsetSubdim0 = bufferGeo.getDataArrayOffsetForHighestOrderSubDim(0);
         REQUIRE(pointers5D[0][0][0][0] == &data[(dataOffsetSubdim0 + 0)]);
         REQUIRE(pointers5D[0][0][0][1] == &data[(dataOffsetSubdim0 + 6)]);
         REQUIRE(pointers5D[0][0][1][0] == &data[(dataOffsetSubdim0 + 3*2*3 +0)]); //+18
         REQUIRE(pointers5D[0][0][1][1] == &data[(dataOffsetSubdim0 + 3*2*3 +6)]); //+24
         REQUIRE(pointers5D[0][2][0][0] == &data[(dataOffsetSubdim0 + 2*2*3*2*3 +0)]); //+72
         
-        const int dataOffsetSubdim1 = bufferGeo.getDataArrayOffsetForHighestOrderSubDim(1);
+        const offset_type dataOffsetSubdim1 = bufferGeo.getDataArrayOffsetForHighestOrderSubDim(1);
         REQUIRE(pointers5D[1][2][0][1] == &data[(dataOffsetSubdim1 + 2*2*3*2*3 +6)]);
     }
 
@@ -231,6 +231,79 @@ TEST_CASE("BufferGeometry Tests")
         REQUIRE(bufferGeo5.getRequiredPointerArraySize() == 1);
     }
 
+    SECTION("Padded rows") {
+        BufferGeometry<3> bufferGeo(std::array<int, 3>{2, 3, 5}, 8);
+        REQUIRE(bufferGeo.getInnermostStride() == 8);
+        REQUIRE(bufferGeo.isPadded());
+        REQUIRE(bufferGeo.getRequiredDataArraySize() == 2*3*8);
+        REQUIRE(bufferGeo.getRequiredPointerArraySize() == 2 + 2*3);
+        CHECK(bufferGeo.getDataArrayOffsetForHighestOrderSubDim(1) == 3*8);
+        
+        float data [2*3*8] {0};
+        float* pointers [2 + 2*3] {nullptr};
+        bufferGeo.hookupPointerArrayToData(data, pointers);
+        float*** pointers3D = reinterpret_cast<float***>(pointers);
+        REQUIRE(pointers3D[0][0] == &data[0]);
+        REQUIRE(pointers3D[0][1] == &data[8]);
+        REQUIRE(pointers3D[1][0] == &data[24]);
+        REQUIRE(pointers3D[1][2] == &data[40]);
+        
+        BufferGeometry<2> subGeo = bufferGeo.getSubDimGeometry();
+        REQUIRE(subGeo.getDimensionExtents() == std::array<int, 2>{3, 5});
+        REQUIRE(subGeo.getInnermostStride() == 8);
+        REQUIRE(subGeo.getRequiredDataArraySize() == 3*8);
+        
+        BufferGeometry<1> paddedGeo1D(std::array<int, 1>{5}, 16);
+        REQUIRE(paddedGeo1D.getRequiredDataArraySize() == 16);
+        
+        BufferGeometry<2> unpaddedGeo(2, 5);
+        REQUIRE_FALSE(unpaddedGeo.isPadded());
+        REQUIRE(unpaddedGeo.getInnermostStride() == 5);
+        
+        REQUIRE_THROWS(BufferGeometry<2>(std::array<int, 2>{2, 5}, 4)); // stride too small
+    }
+
+    SECTION("Strides & element offsets") {
+        BufferGeometry<4> bufferGeo(2, 3, 4, 5);
+        REQUIRE(bufferGeo.getStrides() == std::array<offset_type, 4>{60, 20, 5, 1});
+        REQUIRE(bufferGeo.getDataArrayOffset(0, 0, 0, 0) == 0);
+        REQUIRE(bufferGeo.getDataArrayOffset(1, 2, 3, 4) == 60 + 40 + 15 + 4);
+        REQUIRE(bufferGeo.getDataArrayOffset(1, 0, 0, 0) == bufferGeo.getDataArrayOffsetForHighestOrderSubDim(1));
+        REQUIRE_THROWS(bufferGeo.getDataArrayOffset(2, 0, 0, 0));
+        REQUIRE_THROWS(bufferGeo.getDataArrayOffset(0, 0, 0, 5));
+        REQUIRE_THROWS(bufferGeo.getDataArrayOffset(0, -1, 0, 0));
+
+        BufferGeometry<3> paddedGeo(std::array<int, 3>{2, 3, 5}, 8);
+        REQUIRE(paddedGeo.getStrides() == std::array<offset_type, 3>{24, 8, 1});
+        REQUIRE(paddedGeo.getDataArrayOffset(1, 2, 4) == 24 + 16 + 4);
+        
+        BufferGeometry<1> bufferGeo1D(7);
+        REQUIRE(bufferGeo1D.getStrides() == std::array<offset_type, 1>{1});
+        REQUIRE(bufferGeo1D.getDataArrayOffset(6) == 6);
+        
+        {   // no dynamic memory allocation
+            ScopedMemorySentinel sentinel;
+            offset_type offset = bufferGeo.getDataArrayOffset(1, 1, 1, 1); UNUSED(offset);
+        }
+    }
+
+    SECTION("Sizes & offsets beyond the int range") {
+        // 2^32 elements: only the geometry is computed, nothing is allocated
+        BufferGeometry<2> bigGeo(65536, 65536);
+        REQUIRE(bigGeo.getRequiredDataArraySize() == offset_type(1) << 32);
+        REQUIRE(bigGeo.getDataArrayOffsetForHighestOrderSubDim(65535) == 65535 * offset_type(65536));
+        REQUIRE(bigGeo.getDataArrayOffset(65535, 65535) == (offset_type(1) << 32) - 1);
+
+        BufferGeometry<3> bigPaddedGeo(std::array<int, 3>{3, 2, 5}, 1 << 30);
+        REQUIRE(bigPaddedGeo.getStrides() == std::array<offset_type, 3>{offset_type(2) << 30, offset_type(1) << 30, 1});
+        REQUIRE(bigPaddedGeo.getRequiredDataArraySize() == offset_type(6) << 30);
+        REQUIRE(bigPaddedGeo.getRequiredPointerArraySize() == 3 + 6);
+
+        // sizes not representable in offset_type are detected at construction
+        REQUIRE_THROWS(BufferGeometry<4>(1 << 30, 1 << 30, 1 << 30, 1 << 30));
+        REQUIRE_THROWS(BufferGeometry<3>(std::array<int, 3>{1 << 30, 1 << 30, 1}, 1 << 30));
+    }
+
     SECTION("Allocation in Dynamic containers") {
         constexpr int N = 3;
         int dim1 = 2;
@@ -260,12 +333,12 @@ TEST_CASE("BufferGeometry Tests")
         
         // Verify pointers to data (lowest-order) dimension
         float*** pointers3D = reinterpret_cast<float***>(pointers.data());
-        const int dataOffsetSubdim0 = bufferGeo.getDataArrayOffsetForHighestOrderSubDim(0);
+        const offset_type dataOffsetSubdim0 = bufferGeo.getDataArrayOffsetForHighestOrderSubDim(0);
         REQUIRE(pointers3D[0][0] == &data[dataOffsetSubdim0 + 0]);
         REQUIRE(pointers3D[0][1] == &data[dataOffsetSubdim0 + 6]);
         REQUIRE(pointers3D[0][4] == &data[dataOffsetSubdim0 + 24]);
 
-        const int dataOffsetSubdim1 = bufferGeo.getDataArrayOffsetForHighestOrderSubDim(1);
+        const offset_type dataOffsetSubdim1 = bufferGeo.getDataArrayOffsetForHighestOrderSubDim(1);
         REQUIRE(pointers3D[1][0] == &data[dataOffsetSubdim1 + 0]);
         REQUIRE(pointers3D[1][1] == &data[dataOffsetSubdim1 + 6]);
         REQUIRE(pointers3D[1][4] == &data[dataOffsetSubdim1 + 24]);
@@ -321,3 +394,31 @@ TEST_CASE("BufferGeometry Tests")
         }
     }
 }
+
+TEST_CASE("StaticBufferGeometry Tests")
+{
+    using Geometry = StaticBufferGeometry<2, 3, 4, 5>;
+    
+    // everything is resolved at compile time
+    static_assert(Geometry::N == 4, "");
+    static_assert(Geometry::getRequiredDataArraySize() == 120, "");
+    static_assert(Geometry::getRequiredPointerArraySize() == 2 + 6 + 24, "");
+    static_assert(Geometry::getStrides()[0] == 60 && Geometry::getStrides()[2] == 5 && Geometry::getStrides()[3] == 1, "");
+    static_assert(Geometry::getDataArrayOffset(1, 2, 3, 4) == 60 + 40 + 15 + 4, "");
+    static_assert(Geometry::getDataArrayOffsetForHighestOrderSubDim(1) == 60, "");
+    static_assert(StaticBufferGeometry<7>::getRequiredPointerArraySize() == 1, "");
+    static_assert(!StaticBufferGeometry<7>::isPadded(), "");
+    
+    // identical results as the runtime geometry
+    BufferGeometry<4> runtimeGeometry(2, 3, 4, 5);
+    REQUIRE(Geometry::getDimensionExtents() == runtimeGeometry.getDimensionExtents());
+    REQUIRE(Geometry::getStrides() == runtimeGeometry.getStrides());
+    REQUIRE(Geometry::getSubDimGeometry().getDimensionExtents() == std::array<int, 3>{3, 4, 5});
+    REQUIRE_THROWS(Geometry::getDataArrayOffset(0, 3, 0, 0));
+
+    float data [Geometry::getRequiredDataArraySize()] {0};
+    float* pointers [Geometry::getRequiredPointerArraySize()] {nullptr};
+    Geometry::hookupPointerArrayToData(data, pointers);
+    float**** pointers4D = reinterpret_cast<float****>(pointers);
+    REQUIRE(&pointers4D[1][2][3][4] == &data[Geometry::getDataArrayOffset(1, 2, 3, 4)]);
+}
@@ -0,0 +1,251 @@
+//
+//  ╦ ╦┬ ┬┌─┐┌─┐┬─┐  ╔╗ ┬ ┬┌─┐┌─┐┌─┐┬─┐
+//  ╠═╣└┬┘├─┘├┤ ├┬┘  ╠╩╗│ │├┤ ├┤ ├┤ ├┬┘
+//  ╩ ╩ ┴ ┴  └─┘┴└─  ╚═╝└─┘└  └  └─┘┴└─
+//
+//  © 2023 Lorenz Bucher - all rights reserved
+//  https://github.com/Sidelobe/HyperBuffer
+
+#include "TestCommon.hpp"
+
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include "HyperBuffer.hpp"
+#include "MemorySentinel.hpp"
+
+using namespace slb;
+
+namespace
+{
+/** Fills the buffer with a sequence that depends on the element's indices */
+template<typename B>
+void fillWithSequence(B& buffer, float offset)
+{
+    for (int i=0; i < buffer.size(0); ++i) {
+        for (int j=0; j < buffer.size(1); ++j) {
+            buffer[i][j] = offset + static_cast<float>(i) - 0.25f * static_cast<float>(j);
+        }
+    }
+}
+
+template<typename B, class Expected>
+bool verify(const B& buffer, Expected expected)
+{
+    for (int i=0; i < buffer.size(0); ++i) {
+        for (int j=0; j < buffer.size(1); ++j) {
+            if (buffer[i][j] != expected(i, j)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+} // namespace
+
+TEST_CASE("SimdKernels Tests")
+{
+    // odd lengths exercise the scalar tails
+    for (int n : { 0, 1, 3, 7, 16, 17, 33, 100 }) {
+        std::vector<float> dst(n, 1.f);
+        std::vector<float> src(n);
+        for (int i=0; i < n; ++i) {
+            src[i] = static_cast<float>(i) - 10.f;
+        }
+        SimdKernels::add(dst.data(), src.data(), n);
+        SimdKernels::multiplyAccumulate(dst.data(), src.data(), 0.5f, n);
+        SimdKernels::scale(dst.data(), 2.f, n);
+        SimdKernels::clamp(dst.data(), -20.f, 20.f, n);
+        for (int i=0; i < n; ++i) {
+            const float expected = std::min(std::max((1.f + src[i] + src[i] * 0.5f) * 2.f, -20.f), 20.f);
+            REQUIRE(dst[i] == expected);
+        }
+
+        std::vector<double> dstD(n, 3.0);
+        std::vector<double> srcD(n, 0.5);
+        SimdKernels::multiply(dstD.data(), srcD.data(), n);
+        SimdKernels::subtract(dstD.data(), srcD.data(), n);
+        SimdKernels::multiplyAccumulate(dstD.data(), srcD.data(), srcD.data(), n);
+        for (double d : dstD) {
+            REQUIRE(d == 1.25);
+        }
+
+        std::vector<int> dstI(n);
+        SimdKernels::fill(dstI.data(), 7, n);
+        SimdKernels::copy(dstD.data(), srcD.data(), n);
+        for (int i=0; i < n; ++i) {
+            REQUIRE(dstI[i] == 7);
+            REQUIRE(dstD[i] == 0.5);
+        }
+    }
+
+    SECTION("NaN propagates through min & max, in the vector body and the tail") {
+        const float nan = std::numeric_limits<float>::quiet_NaN();
+        const offset_type n = 37;
+        std::vector<float> values(n, 5.f);
+        values[1] = nan;
+        values[n-1] = nan;
+        std::vector<float> other(n, -2.f);
+        other[2] = nan;
+        other[n-2] = nan;
+
+        std::vector<float> clamped(values);
+        SimdKernels::clamp(clamped.data(), 0.f, 1.f, n);
+        std::vector<float> minima(values);
+        SimdKernels::accumulateMin(minima.data(), other.data(), n);
+        std::vector<float> maxima(values);
+        SimdKernels::accumulateMax(maxima.data(), other.data(), n);
+        std::vector<float> peaks(values);
+        SimdKernels::accumulatePeak(peaks.data(), other.data(), n);
+        for (offset_type i=0; i < n; ++i) {
+            const bool valueIsNaN = (i == 1 || i == n-1);
+            const bool eitherIsNaN = valueIsNaN || i == 2 || i == n-2;
+            REQUIRE(std::isnan(clamped[i]) == valueIsNaN);
+            REQUIRE(std::isnan(minima[i]) == eitherIsNaN);
+            REQUIRE(std::isnan(maxima[i]) == eitherIsNaN);
+            REQUIRE(std::isnan(peaks[i]) == eitherIsNaN);
+            if (!eitherIsNaN) {
+                REQUIRE(clamped[i] == 1.f);
+                REQUIRE(minima[i] == -2.f);
+                REQUIRE(maxima[i] == 5.f);
+                REQUIRE(peaks[i] == 5.f);
+            }
+        }
+
+        std::vector<double> clampedD { 0.5, std::numeric_limits<double>::quiet_NaN(), 2.0, -1.0, 0.5 };
+        SimdKernels::clamp(clampedD.data(), 0.0, 1.0, 5);
+        REQUIRE(std::isnan(clampedD[1]));
+        REQUIRE(clampedD[2] == 1.0);
+        REQUIRE(clampedD[3] == 0.0);
+    }
+}
+
+TEST_CASE("BufferOperations Tests")
+{
+    SECTION("flat buffers") {
+        HyperBuffer<float, 2> a(3, 37);
+        HyperBuffer<float, 2> b(3, 37);
+        fillWithSequence(a, 0.f);
+        fillWithSequence(b, 10.f);
+        auto valueA = [](int i, int j) { return 0.f + static_cast<float>(i) - 0.25f * static_cast<float>(j); };
+        auto valueB = [](int i, int j) { return 10.f + static_cast<float>(i) - 0.25f * static_cast<float>(j); };
+
+        ScopedMemorySentinel sentinel;
+        BufferOperations::add(a, b);
+        REQUIRE(verify(a, [&](int i, int j) { return valueA(i, j) + valueB(i, j); }));
+        BufferOperations::subtract(a, b);
+        REQUIRE(verify(a, valueA));
+        BufferOperations::multiply(a, b);
+        REQUIRE(verify(a, [&](int i, int j) { return valueA(i, j) * valueB(i, j); }));
+        BufferOperations::copy(a, b);
+        REQUIRE(verify(a, valueB));
+        BufferOperations::scale(a, 0.5f);
+        REQUIRE(verify(a, [&](int i, int j) { return valueB(i, j) * 0.5f; }));
+        BufferOperations::multiplyAccumulate(a, b, 2.f);
+        REQUIRE(verify(a, [&](int i, int j) { return valueB(i, j) * 0.5f + valueB(i, j) * 2.f; }));
+        BufferOperations::fill(a, 1);
+        BufferOperations::multiplyAccumulate(a, b, b);
+        REQUIRE(verify(a, [&](int i, int j) { return 1.f + valueB(i, j) * valueB(i, j); }));
+        BufferOperations::clamp(a, 0, 100);
+        REQUIRE(verify(a, [&](int i, int j) { return std::min(1.f + valueB(i, j) * valueB(i, j), 100.f); }));
+    }
+
+    SECTION("padded, non-contiguous & mixed storage") {
+        HyperBufferAligned<float, 2, 64> padded(3, 37);
+        fillWithSequence(padded, 0.f);
+
+        std::vector<float> ch0(37), ch1(37), ch2(37);
+        float* channels[] = { ch0.data(), ch1.data(), ch2.data() };
+        HyperBufferViewNC<float, 2> nonContiguous(channels, 3, 37);
+        fillWithSequence(nonContiguous, 10.f);
+
+        StaticHyperBuffer<float, 3, 37> staticBuffer;
+        BufferOperations::fill(staticBuffer, -1.f);
+
+        ScopedMemorySentinel sentinel;
+        BufferOperations::add(padded, nonContiguous);
+        REQUIRE(verify(padded, [](int i, int j) { return 10.f + 2.f * (static_cast<float>(i) - 0.25f * static_cast<float>(j)); }));
+        BufferOperations::copy(nonContiguous, staticBuffer);
+        REQUIRE(verify(nonContiguous, [](int, int) { return -1.f; }));
+        BufferOperations::multiplyAccumulate(staticBuffer, padded, nonContiguous);
+        REQUIRE(verify(staticBuffer, [](int i, int j) { return -1.f - (10.f + 2.f * (static_cast<float>(i) - 0.25f * static_cast<float>(j))); }));
+    }
+
+    SECTION("sub-views & 1D") {
+        HyperBuffer<double, 3> buffer(2, 3, 5);
+        BufferOperations::fill(buffer, 2.0);
+        auto subView = buffer.subView(1);
+        BufferOperations::scale(subView, 3.0);
+        REQUIRE(buffer[0][2][4] == 2.0);
+        REQUIRE(buffer[1][0][0] == 6.0);
+        REQUIRE(buffer[1][2][4] == 6.0);
+
+        auto row = buffer.subView(0, 1);
+        HyperBuffer<double, 1> ramp(5);
+        for (int i=0; i < 5; ++i) {
+            ramp[i] = i;
+        }
+        BufferOperations::add(row, ramp);
+        REQUIRE(buffer[0][1][4] == 6.0);
+        REQUIRE(buffer[0][0][4] == 2.0);
+
+        HyperBuffer<int, 2> integers(2, 9); // no SIMD specialization: scalar path
+        BufferOperations::fill(integers, 5);
+        BufferOperations::clamp(integers, 0, 3);
+        REQUIRE(integers[1][8] == 3);
+    }
+
+    SECTION("mismatching extents") {
+        HyperBuffer<float, 2> a(3, 37);
+        HyperBuffer<float, 2> b(3, 36);
+        REQUIRE_THROWS(BufferOperations::add(a, b));
+        REQUIRE_THROWS(BufferOperations::clamp(a, 1.f, 0.f));
+    }
+}
+
+TEST_CASE("Interleaving Tests")
+{
+    SECTION("round trip: all channel counts, with & without SIMD shuffles") {
+        const int numChannels = GENERATE(1, 2, 3, 4, 5, 6, 8, 11);
+        const int numFrames = 37; // not a multiple of the SIMD width
+        std::vector<float> interleaved(static_cast<std::size_t>(numChannels * numFrames));
+        for (std::size_t i=0; i < interleaved.size(); ++i) {
+            interleaved[i] = static_cast<float>(i);
+        }
+
+        HyperBuffer<float, 2> channels(numChannels, numFrames);
+        {   // no dynamic memory allocation
+            ScopedMemorySentinel sentinel;
+            BufferOperations::deinterleave(channels, interleaved.data());
+        }
+        REQUIRE(verify(channels, [=](int ch, int i) { return static_cast<float>(i * numChannels + ch); }));
+
+        std::vector<float> result(interleaved.size());
+        BufferOperations::interleave(result.data(), channels);
+        REQUIRE(result == interleaved);
+    }
+
+    SECTION("other storage policies & data types") {
+        const float interleaved[] = { 0, 10, 1, 11, 2, 12, 3, 13, 4, 14 };
+        std::vector<float> left(5), right(5);
+        float* channelPointers[] = { left.data(), right.data() };
+        HyperBufferViewNC<float, 2> nonContiguous(channelPointers, 2, 5);
+        BufferOperations::deinterleave(nonContiguous, interleaved);
+        REQUIRE(left[4] == 4.f);
+        REQUIRE(right[3] == 13.f);
+
+        std::vector<float> data(2 * 5);
+        HyperBufferView<float, 2> view(data.data(), 2, 5);
+        BufferOperations::deinterleave(view, interleaved);
+        REQUIRE(data[9] == 14.f);
+
+        const std::int16_t interleaved16[] = { 1, -1, 2, -2, 3, -3 };
+        HyperBuffer<std::int16_t, 2> buffer16(2, 3);
+        BufferOperations::deinterleave(buffer16, interleaved16);
+        REQUIRE(buffer16[1][2] == -3);
+        std::int16_t result16[6];
+        BufferOperations::interleave(result16, buffer16);
+        REQUIRE(std::equal(result16, result16 + 6, interleaved16));
+    }
+}
@@ -0,0 +1,154 @@
+//
+//  ╦ ╦┬ ┬┌─┐┌─┐┬─┐  ╔╗ ┬ ┬┌─┐┌─┐┌─┐┬─┐
+//  ╠═╣└┬┘├─┘├┤ ├┬┘  ╠╩╗│ │├┤ ├┤ ├┤ ├┬┘
+//  ╩ ╩ ┴ ┴  └─┘┴└─  ╚═╝└─┘└  └  └─┘┴└─
+//
+//  © 2023 Lorenz Bucher - all rights reserved
+//  https://github.com/Sidelobe/HyperBuffer
+
+#include "TestCommon.hpp"
+#include "MemorySentinel.hpp"
+
+#include <numeric>
+#include <vector>
+
+#include "Expressions.hpp"
+
+using namespace slb;
+
+TEST_CASE("Expressions Tests")
+{
+    HyperBuffer<float, 2> a(3, 37);
+    HyperBuffer<float, 2> b(3, 37);
+    std::iota(a.flat().begin(), a.flat().end(), 0.f);
+    std::iota(b.flat().begin(), b.flat().end(), 100.f);
+
+    SECTION("fused evaluation, flat") {
+        HyperBuffer<float, 2> out(3, 37);
+        const float gain = 0.5f;
+        {   // no dynamic memory allocation
+            ScopedMemorySentinel sentinel;
+            out = a * gain + b;
+        }
+        for (int ch = 0; ch < 3; ++ch) {
+            for (int i = 0; i < 37; ++i) {
+                REQUIRE(out[ch][i] == a[ch][i] * gain + b[ch][i]);
+            }
+        }
+
+        out = 2.f - (a - b) * a + 1.f;
+        REQUIRE(out[2][36] == 2.f - (110.f - 210.f) * 110.f + 1.f);
+        out = -a;
+        REQUIRE(out[1][3] == -40.f);
+        out = max(min(a, 50.f), b * 0.f + 10.f);
+        REQUIRE(out[0][0] == 10.f);
+        REQUIRE(out[1][0] == 37.f);
+        REQUIRE(out[2][30] == 50.f);
+        out = min(a, b) + max(a, b);
+        REQUIRE(out[1][1] == 38.f + 138.f);
+
+        // the destination can be an operand
+        a = a * 0.5f + a;
+        REQUIRE(a[2][36] == 110.f * 1.5f);
+    }
+
+    SECTION("mixed storage policies, row by row") {
+        HyperBufferAligned<float, 2, 64> padded(3, 37);
+        padded = a + 0.f;
+        REQUIRE(padded[2][36] == 110.f);
+
+        std::vector<std::vector<float>> rows(3, std::vector<float>(37));
+        float* rowPointers[3] = { rows[1].data(), rows[2].data(), rows[0].data() };
+        HyperBufferViewNC<float, 2> nonContiguous(rowPointers, 3, 37);
+        {   // no dynamic memory allocation
+            ScopedMemorySentinel sentinel;
+            nonContiguous = padded * b - a;
+        }
+        REQUIRE(rows[0][5] == 79.f * 179.f - 79.f);
+        REQUIRE(nonContiguous[0][36] == 36.f * 136.f - 36.f);
+
+        HyperBuffer<float, 1> channel(37);
+        channel = a.subView(1) + nonContiguous.subView(2) * 2.f;
+        REQUIRE(channel[0] == 37.f + 2.f * (74.f * 174.f - 74.f));
+
+        HyperBuffer<double, 3> cube(2, 2, 5);
+        BufferOperations::fill(cube, 1.0);
+        HyperBuffer<double, 3> result(2, 2, 5);
+        result = cube * 3.0 - cube;
+        REQUIRE(result[1][1][4] == 2.0);
+
+        HyperBuffer<int, 2> integers(2, 3);
+        BufferOperations::fill(integers, 4);
+        integers = integers * integers - 1;
+        REQUIRE(integers[1][2] == 15);
+    }
+
+    SECTION("strided & broadcast operands") {
+        HyperBuffer<float, 1> gains(3);
+        gains[0] = 0.5f; gains[1] = 1.f; gains[2] = -2.f;
+        HyperBuffer<float, 2> out(3, 37);
+        {   // no dynamic memory allocation
+            ScopedMemorySentinel sentinel;
+            out = a * gains.broadcast<2>({ 3, 37 }, { 0 }); // gain per channel
+        }
+        for (int i = 0; i < 37; ++i) {
+            REQUIRE(out[0][i] == a[0][i] * 0.5f);
+            REQUIRE(out[2][i] == a[2][i] * -2.f);
+        }
+
+        HyperBuffer<float, 1> window(37);
+        std::iota(window.begin(), window.end(), 1.f);
+        out = b * window.broadcast<2>({ 3, 37 }) + a; // window per row
+        REQUIRE(out[2][36] == 210.f * 37.f + 110.f);
+        REQUIRE(out[1][0] == 137.f + 37.f);
+
+        // reversed: strided access in every row
+        out = a.slice(1, 36, 37, -1) - a;
+        REQUIRE(out[1][0] == 73.f - 37.f);
+        REQUIRE(out[2][36] == 74.f - 110.f);
+
+        HyperBuffer<float, 3> spectrogram(2, 4, 37);
+        BufferOperations::fill(spectrogram, 1.f);
+        HyperBuffer<float, 3> weighted(2, 4, 37);
+        weighted = spectrogram * window.broadcast<3>({ 2, 4, 37 }) * gains.slice(0, 0, 2).broadcast<3>({ 2, 4, 37 }, { 0 });
+        REQUIRE(weighted[1][3][36] == 37.f);
+        REQUIRE(weighted[0][2][9] == 5.f);
+
+        // 1D: strided & broadcast operands in the only row
+        HyperBuffer<float, 1> ramp(8);
+        std::iota(ramp.begin(), ramp.end(), 0.f);
+        HyperBuffer<float, 1> ones(4);
+        BufferOperations::fill(ones, 1.f);
+        HyperBuffer<float, 1> result(4);
+        result = ramp.slice(0, 0, 4) * 0.f + ramp.slice(0, 0, 4, 2);
+        REQUIRE(result[3] == 6.f);
+        result = ones * ramp.slice(0, 3, 4, -1);
+        REQUIRE(result[0] == 3.f);
+        REQUIRE(result[3] == 0.f);
+        result = ones * gains.slice(0, 2, 1).broadcast<1>({ 4 });
+        for (int i = 0; i < 4; ++i) {
+            REQUIRE(result[i] == -2.f);
+        }
+
+        // innermost extent 1: flat, whatever the innermost stride
+        HyperBuffer<float, 2> column(4, 1);
+        BufferOperations::fill(column, 1.f);
+        HyperBuffer<float, 2> columnResult(4, 1);
+        columnResult = column * ramp.slice(0, 0, 4).broadcast<2>({ 4, 1 }, { 0 });
+        REQUIRE(columnResult[1][0] == 1.f);
+        REQUIRE(columnResult[3][0] == 3.f);
+        HyperBuffer<float, 2> rampColumn(4, 1);
+        std::iota(rampColumn.flat().begin(), rampColumn.flat().end(), 10.f);
+        columnResult = column + rampColumn.slice(1, 0, 1, 5);
+        REQUIRE(columnResult[0][0] == 11.f);
+        REQUIRE(columnResult[3][0] == 14.f);
+    }
+
+    SECTION("extents are checked") {
+        HyperBuffer<float, 2> other(3, 36);
+        HyperBuffer<float, 2> out(3, 37);
+        REQUIRE_THROWS(a + other);
+        REQUIRE_THROWS(other = a * 2.f);
+        REQUIRE_NOTHROW(out = a * 2.f);
+    }
+}
@@ -0,0 +1,93 @@
+//
+//  ╦ ╦┬ ┬┌─┐┌─┐┬─┐  ╔╗ ┬ ┬┌─┐┌─┐┌─┐┬─┐
+//  ╠═╣└┬┘├─┘├┤ ├┬┘  ╠╩╗│ │├┤ ├┤ ├┤ ├┬┘
+//  ╩ ╩ ┴ ┴  └─┘┴└─  ╚═╝└─┘└  └  └─┘┴└─
+//
+//  © 2023 Lorenz Bucher - all rights reserved
+//  https://github.com/Sidelobe/HyperBuffer
+
+#include "TestCommon.hpp"
+#include "MemorySentinel.hpp"
+
+#include "HyperBufferCircular.hpp"
+
+using namespace slb;
+
+TEST_CASE("HyperBufferCircular Tests")
+{
+    SECTION("windows across the wrap point are contiguous") {
+        HyperBufferCircular<float, 2> delayLine(2, 10);
+        REQUIRE(delayLine.capacity() == 10);
+        REQUIRE(delayLine.size(0) == 2);
+        REQUIRE(delayLine.size(1) == 10);
+
+        HyperBuffer<float, 2> block(2, 4);
+        float sample = 0;
+        {   // no dynamic memory allocation
+            ScopedMemorySentinel sentinel;
+            for (int b = 0; b < 4; ++b) { // samples 0-15: the write head wraps once
+                for (int i=0; i < 4; ++i) {
+                    block[0][i] = sample;
+                    block[1][i] = -sample;
+                    sample += 1.f;
+                }
+                delayLine.write(block);
+            }
+        }
+        REQUIRE(delayLine.getWritePosition() == 6);
+
+        auto latest = delayLine.getWindow(4);
+        REQUIRE(latest.sizes() == std::array<int, 2>{2, 4});
+        REQUIRE(latest[0][0] == 12.f);
+        REQUIRE(latest[1][3] == -15.f);
+
+        auto history = delayLine.getWindow(8, 2); // samples 6-13: crosses the wrap point
+        const float* samples = &history[0][0];
+        for (int i=0; i < 8; ++i) {
+            REQUIRE(samples[i] == static_cast<float>(6 + i)); // one contiguous row
+        }
+        REQUIRE(history.stride(1) == 1);
+        REQUIRE(history[1][7] == -13.f);
+
+        auto oldest = delayLine.getWindow(1, 9);
+        REQUIRE(oldest[0][0] == 6.f);
+
+        HyperBuffer<float, 2> output(2, 4);
+        BufferOperations::fill(output, 0.f);
+        auto tap = delayLine.getWindow(4, 4); // samples 8-11
+        for (int i=0; i < 4; ++i) {
+            output[0][i] += 0.5f * tap[0][i];
+        }
+        REQUIRE(output[0][3] == 5.5f);
+
+        REQUIRE_THROWS(delayLine.getWindow(8, 3));
+        HyperBuffer<float, 2> tooLong(2, 11);
+        REQUIRE_THROWS(delayLine.write(tooLong));
+        HyperBuffer<float, 2> wrongChannels(3, 4);
+        REQUIRE_THROWS(delayLine.write(wrongChannels));
+
+        delayLine.clear();
+        REQUIRE(delayLine.getWindow(10)[0][9] == 0.f);
+        REQUIRE(delayLine.getWritePosition() == 0);
+    }
+
+    SECTION("1D & 3D") {
+        HyperBufferCircular<int, 1> history(3);
+        REQUIRE(history.getWindow(3)[2] == 0); // silence initially
+        HyperBuffer<int, 1> values(2);
+        values[0] = 1; values[1] = 2;
+        history.write(values);
+        history.write(values);
+        REQUIRE(history.getWindow(3)[0] == 2);
+        REQUIRE(history.getWindow(3)[1] == 1);
+        REQUIRE(history.getWindow(3)[2] == 2);
+
+        HyperBufferCircular<double, 3> voices(2, 3, 5);
+        HyperBuffer<double, 3> block(2, 3, 4);
+        BufferOperations::fill(block, 1.0);
+        voices.write(block);
+        voices.write(block);
+        REQUIRE(voices.getWindow(5)[1][2][4] == 1.0);
+        REQUIRE(voices.getWindow(5, 0).sizes() == std::array<int, 3>{2, 3, 5});
+    }
+}
@@ -34,6 +34,11 @@ static_assert(std::is_copy_assignable<HyperBuffer<int, 3>>::value, "should be Co
 static_assert(std::is_nothrow_move_constructible<HyperBuffer<int, 3>>::value, "should be noexcept Move-Constructible");
 static_assert(std::is_nothrow_move_assignable<HyperBuffer<int, 3>>::value, "should be noexcept Move-Assignable");
 
+static_assert(std::is_copy_constructible<HyperBufferSingleBlock<int, 3>>::value, "should be Copy-Constructible");
+static_assert(std::is_copy_assignable<HyperBufferSingleBlock<int, 3>>::value, "should be Copy-Assignable");
+static_assert(std::is_nothrow_move_constructible<HyperBufferSingleBlock<int, 3>>::value, "should be noexcept Move-Constructible");
+static_assert(std::is_nothrow_move_assignable<HyperBufferSingleBlock<int, 3>>::value, "should be noexcept Move-Assignable");
+
 static_assert(std::is_copy_constructible<HyperBufferView<int, 3>>::value, "should be Copy-Constructible");
 static_assert(std::is_copy_assignable<HyperBufferView<int, 3>>::value, "should be Copy-Assignable");
 static_assert(std::is_nothrow_move_constructible<HyperBufferView<int, 3>>::value, "should be noexcept Move-Constructible");
@@ -62,6 +67,12 @@ TEST_CASE("Copy/Move a HyperBuffer with internal allocation")
     verifyBuffer(bufferCopy);
     verifyBuffer(buffer); // original remains untouched
     
+    // Copies have their own data
+    REQUIRE(bufferCopy[1][0] != buffer[1][0]);
+    REQUIRE(bufferCopyCtor[2][1] != buffer[2][1]);
+    bufferCopyCtor[2][1][3] = 1;
+    REQUIRE(buffer[2][1][3] == -666);
+    
     // verify no memory is allocated during copy to buffer with same size
     HyperBuffer<int, N> bufferCopySameSize(dims);
     {
@@ -134,6 +145,51 @@ TEST_CASE("Copy/Move a HyperBuffer with internal allocation")
     
 }
 
+TEST_CASE("Copy/Move a HyperBuffer with internal single-block allocation")
+{
+    constexpr int N = 3;
+    std::array<int, N> dims {3, 2, 8};
+    HyperBufferSingleBlock<int, N> buffer(dims);
+    buffer[1][0][5] = 333;
+    buffer[2][1][3] = -666;
+    
+    // Copy Ctor
+    HyperBufferSingleBlock<int, N> bufferCopy(buffer);
+    verifyBuffer(bufferCopy);
+    verifyBuffer(buffer); // original remains untouched
+    REQUIRE(bufferCopy[1][0] != buffer[1][0]); // copy has its own data
+    
+    // verify no memory is allocated during copy to buffer with same size
+    HyperBufferSingleBlock<int, N> bufferCopySameSize(dims);
+    {
+        ScopedMemorySentinel sentinel;
+        bufferCopySameSize = buffer;
+    }
+    verifyBuffer(bufferCopySameSize);
+    
+    // this will work, but will allocate memory
+    HyperBufferSingleBlock<int, N> bufferCopySmallerSize(2, 2, 6);
+    bufferCopySmallerSize = buffer;
+    verifyBuffer(bufferCopySmallerSize);
+    
+    // Move: no allocation, data stays in place
+    {
+        HyperBufferSingleBlock<int, N> bufferMovedFrom = buffer; // working copy
+        int* dataLocation = &bufferMovedFrom[2][1][3];
+        HyperBufferSingleBlock<int, N> bufferMovedTo(1, 1, 1);
+        {
+            ScopedMemorySentinel sentinel;
+            bufferMovedTo = std::move(bufferMovedFrom);
+        }
+        verifyBuffer(bufferMovedTo);
+        REQUIRE(&bufferMovedTo[2][1][3] == dataLocation);
+        
+        HyperBufferSingleBlock<int, N> bufferMovedToCtor(std::move(bufferMovedTo));
+        verifyBuffer(bufferMovedToCtor);
+        REQUIRE(&bufferMovedToCtor[2][1][3] == dataLocation);
+    }
+}
+
 TEST_CASE("Copy/Move a HyperBuffer with external, flat allocation")
 {
     constexpr int N = 3;
@@ -0,0 +1,120 @@
+//
+//  ╦ ╦┬ ┬┌─┐┌─┐┬─┐  ╔╗ ┬ ┬┌─┐┌─┐┌─┐┬─┐
+//  ╠═╣└┬┘├─┘├┤ ├┬┘  ╠╩╗│ │├┤ ├┤ ├┤ ├┬┘
+//  ╩ ╩ ┴ ┴  └─┘┴└─  ╚═╝└─┘└  └  └─┘┴└─
+//
+//  © 2023 Lorenz Bucher - all rights reserved
+//  https://github.com/Sidelobe/HyperBuffer
+
+#include "TestCommon.hpp"
+#include "MemorySentinel.hpp"
+
+#include <algorithm>
+#include <numeric>
+#include <vector>
+
+#include "HyperBuffer.hpp"
+
+using namespace slb;
+
+TEST_CASE("HyperBuffer Iterators")
+{
+    SECTION("flat: raw pointers over contiguous data") {
+        HyperBuffer<int, 3> buffer(2, 3, 4);
+        std::iota(buffer.flat().begin(), buffer.flat().end(), 0);
+        REQUIRE(buffer.flat().size() == 24);
+        REQUIRE(buffer[1][2][3] == 23);
+        REQUIRE(buffer.at(1, 0, 1) == 13);
+
+        const auto& constBuffer = buffer;
+        REQUIRE(std::accumulate(constBuffer.flat().begin(), constBuffer.flat().end(), 0) == 276);
+        std::transform(buffer.flat().begin(), buffer.flat().end(), buffer.flat().begin(), [](int x) { return 2 * x; });
+        REQUIRE(*std::max_element(constBuffer.flat().begin(), constBuffer.flat().end()) == 46);
+
+        HyperBufferAligned<float, 2, 32> padded(2, 3);
+        REQUIRE_THROWS(padded.flat());
+    }
+
+    SECTION("begin()/end(): sub-views of the highest-order dimension") {
+        HyperBuffer<float, 3> buffer(3, 2, 4);
+        {   // no dynamic memory allocation
+            ScopedMemorySentinel sentinel;
+            int i = 0;
+            for (auto subBuffer : buffer) {
+                for (auto row : subBuffer) {
+                    for (float& element : row) {
+                        element = static_cast<float>(i);
+                    }
+                }
+                ++i;
+            }
+        }
+        REQUIRE(buffer[2][1][3] == 2.f);
+        REQUIRE(buffer[0][0][0] == 0.f);
+        REQUIRE(std::distance(buffer.begin(), buffer.end()) == 3);
+        REQUIRE((*(buffer.begin() + 1)).sizes() == std::array<int, 2>{2, 4});
+        REQUIRE(buffer.begin()[2][1][0] == 2.f);
+
+        const auto& constBuffer = buffer;
+        auto last = constBuffer.end() - 1;
+        REQUIRE((*last)[0][0] == 2.f);
+        REQUIRE(last > constBuffer.begin());
+        REQUIRE(std::count_if(constBuffer.begin(), constBuffer.end(), [](auto sub) { return sub[0][0] > 0.f; }) == 2);
+    }
+
+    SECTION("rows() & elements(): segmented iteration over non-contiguous data") {
+        std::vector<float> rowData[4];
+        float* rowPointers[4];
+        for (int i=0; i < 4; ++i) {
+            rowData[i].assign(3, 0.f);
+        }
+        // rows of each sub-dimension in reverse order in memory
+        rowPointers[0] = rowData[1].data(); rowPointers[1] = rowData[0].data();
+        rowPointers[2] = rowData[3].data(); rowPointers[3] = rowData[2].data();
+        float** subPointers[2] = { &rowPointers[0], &rowPointers[2] };
+        HyperBufferViewNC<float, 3> nonContiguous(subPointers, 2, 2, 3);
+
+        {   // no dynamic memory allocation
+            ScopedMemorySentinel sentinel;
+            std::iota(nonContiguous.elements().begin(), nonContiguous.elements().end(), 0.f);
+        }
+        REQUIRE(nonContiguous[0][1][2] == 5.f);
+        REQUIRE(nonContiguous[1][0][0] == 6.f);
+        REQUIRE(rowData[0][0] == 3.f);
+
+        REQUIRE(nonContiguous.rows().size() == 4);
+        const auto& constView = nonContiguous;
+        auto row = constView.rows()[3];
+        REQUIRE(row.size() == 3);
+        REQUIRE(row[0] == 9.f);
+        REQUIRE(std::accumulate(constView.elements().begin(), constView.elements().end(), 0.f) == 66.f);
+
+        std::vector<float> copied(12);
+        std::copy(constView.elements().begin(), constView.elements().end(), copied.begin());
+        REQUIRE(copied[11] == 11.f);
+
+        int numRows = 0;
+        for (auto r : nonContiguous.rows()) {
+            std::fill(r.begin(), r.end(), static_cast<float>(numRows++));
+        }
+        REQUIRE(nonContiguous[1][0][2] == 2.f);
+    }
+
+    SECTION("rows() & elements(): padded & 1D") {
+        HyperBufferAligned<double, 2, 64> padded(3, 5);
+        double value = 0;
+        for (double& element : padded.elements()) {
+            element = value++;
+        }
+        REQUIRE(padded[2][4] == 14.0);
+        for (auto row : padded.rows()) {
+            REQUIRE(row.end() - row.begin() == 5);
+        }
+
+        HyperBuffer<int, 1> buffer(4);
+        std::iota(buffer.begin(), buffer.end(), 1);
+        REQUIRE(std::accumulate(buffer.elements().begin(), buffer.elements().end(), 0) == 10);
+        REQUIRE(buffer.rows().size() == 1);
+        REQUIRE(buffer.rows()[0][3] == 4);
+    }
+}
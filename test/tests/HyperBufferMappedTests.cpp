@@ -0,0 +1,160 @@
+//
+//  ╦ ╦┬ ┬┌─┐┌─┐┬─┐  ╔╗ ┬ ┬┌─┐┌─┐┌─┐┬─┐
+//  ╠═╣└┬┘├─┘├┤ ├┬┘  ╠╩╗│ │├┤ ├┤ ├┤ ├┬┘
+//  ╩ ╩ ┴ ┴  └─┘┴└─  ╚═╝└─┘└  └  └─┘┴└─
+//
+//  © 2023 Lorenz Bucher - all rights reserved
+//  https://github.com/Sidelobe/HyperBuffer
+
+#include "TestCommon.hpp"
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <vector>
+
+#include "HyperBufferMapped.hpp"
+
+using namespace slb;
+
+static_assert(!std::is_copy_constructible<HyperBufferMapped<float, 2>>::value, "mappings must not be copied");
+static_assert(std::is_nothrow_move_constructible<HyperBufferMapped<float, 2>>::value, "should be movable");
+
+namespace
+{
+/** Writes the given bytes to a file, which is deleted when going out of scope */
+class TemporaryFile
+{
+public:
+    TemporaryFile(const std::string& path, const std::vector<char>& content) : m_path(path)
+    {
+        std::ofstream file(m_path, std::ios::binary | std::ios::trunc);
+        file.write(content.data(), static_cast<std::streamsize>(content.size()));
+    }
+    ~TemporaryFile() { std::remove(m_path.c_str()); }
+
+    const std::string& path() const { return m_path; }
+
+    std::vector<char> read() const
+    {
+        std::ifstream file(m_path, std::ios::binary);
+        return std::vector<char>(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    }
+
+private:
+    std::string m_path;
+};
+
+/** @returns the bytes of `header`, followed by the values 0, 1, 2 ... (as float) */
+std::vector<char> createFileContent(int numValues, const std::string& header = "")
+{
+    std::vector<char> content(header.begin(), header.end());
+    for (int i=0; i < numValues; ++i) {
+        const float value = static_cast<float>(i);
+        const char* bytes = reinterpret_cast<const char*>(&value);
+        content.insert(content.end(), bytes, bytes + sizeof(float));
+    }
+    return content;
+}
+} // namespace
+
+TEST_CASE("MappedFile Tests")
+{
+    TemporaryFile file("MappedFileTest.bin", createFileContent(3000));
+
+    SECTION("map ranges") {
+        MappedFile whole(file.path(), MappedFile::Mode::ReadOnly);
+        REQUIRE(whole.isMapped());
+        REQUIRE(whole.size() == 3000 * sizeof(float));
+        REQUIRE(static_cast<const float*>(whole.data())[2999] == 2999.f);
+
+        // offset not aligned to a page boundary
+        MappedFile range(file.path(), MappedFile::Mode::ReadOnly, 1100 * sizeof(float), 10 * sizeof(float));
+        REQUIRE(range.size() == 10 * sizeof(float));
+        REQUIRE(static_cast<const float*>(range.data())[0] == 1100.f);
+        range.advise(MappedFile::AccessHint::Sequential);
+        range.advise(MappedFile::AccessHint::WillNeed);
+
+        MappedFile moved(std::move(range));
+        REQUIRE_FALSE(range.isMapped());
+        REQUIRE(static_cast<const float*>(moved.data())[9] == 1109.f);
+        moved = std::move(whole);
+        REQUIRE(moved.size() == 3000 * sizeof(float));
+    }
+
+    SECTION("invalid arguments") {
+        REQUIRE_THROWS(MappedFile("DoesNotExist.bin", MappedFile::Mode::ReadOnly));
+        REQUIRE_THROWS(MappedFile(file.path(), MappedFile::Mode::ReadOnly, 0, 3001 * sizeof(float)));
+        REQUIRE_THROWS(MappedFile(file.path(), MappedFile::Mode::CopyOnWrite, 3000 * sizeof(float)));
+    }
+}
+
+TEST_CASE("HyperBuffer: memory-mapped storage")
+{
+    SECTION("read-only") {
+        TemporaryFile file("HyperBufferMappedTest.bin", createFileContent(2*3*4));
+        HyperBufferMapped<const float, 3> buffer(file.path(), MappedFile::Mode::ReadOnly, 2, 3, 4);
+        REQUIRE(buffer.sizes() == std::array<int, 3>{2, 3, 4});
+        REQUIRE(buffer[0][0][0] == 0.f);
+        REQUIRE(buffer[1][2][3] == 23.f);
+        REQUIRE(buffer.at(1, 0, 2) == 14.f);
+        REQUIRE(buffer.subView(1, 1)[0] == 16.f);
+        REQUIRE(buffer.stridedView()[0][2][1] == 9.f);
+
+        // read-only mappings require a const data type
+        REQUIRE_THROWS(HyperBufferMapped<float, 3>(file.path(), MappedFile::Mode::ReadOnly, 2, 3, 4));
+        // file too short
+        REQUIRE_THROWS(HyperBufferMapped<const float, 3>(file.path(), MappedFile::Mode::ReadOnly, 2, 3, 5));
+        REQUIRE_THROWS(HyperBufferMapped<const float, 3>(file.path(), MappedFile::Mode::ReadOnly, 2, 0, 4));
+    }
+
+    SECTION("data behind a header, with access hint") {
+        TemporaryFile file("HyperBufferMappedTest.bin", createFileContent(2*100, "HEADER--"));
+        MappedFile::Options options;
+        options.offset = 8;
+        options.hint = MappedFile::AccessHint::Sequential;
+        const HyperBufferMapped<const float, 2> buffer(file.path(), options, 2, 100);
+        REQUIRE(buffer[1][99] == 199.f);
+
+        options.offset = 7; // misaligned
+        REQUIRE_THROWS(HyperBufferMapped<const float, 2>(file.path(), options, 2, 100));
+    }
+
+    SECTION("read-write: creates the file and writes back") {
+        TemporaryFile file("HyperBufferMappedTest.bin", {});
+        {
+            HyperBufferMapped<float, 2> buffer(file.path(), MappedFile::Mode::ReadWrite, 2, 3);
+            for (int i=0; i < 2; ++i) {
+                for (int j=0; j < 3; ++j) {
+                    buffer[i][j] = static_cast<float>(i * 3 + j);
+                }
+            }
+            HyperBufferMapped<float, 2> moved(std::move(buffer));
+            moved[1][2] = -1.f;
+        }
+        std::vector<char> expected = createFileContent(6);
+        const float lastValue = -1.f;
+        std::memcpy(&expected[5 * sizeof(float)], &lastValue, sizeof(float));
+        REQUIRE(file.read() == expected);
+    }
+
+    SECTION("copy-on-write: leaves the file untouched") {
+        TemporaryFile file("HyperBufferMappedTest.bin", createFileContent(16));
+        HyperBufferMapped<float, 1> buffer(file.path(), MappedFile::Mode::CopyOnWrite, 16);
+        buffer[3] = 42.f;
+        REQUIRE(buffer[3] == 42.f);
+
+        HyperBufferMapped<const float, 1> original(file.path(), MappedFile::Mode::ReadOnly, 16);
+        REQUIRE(original[3] == 3.f);
+        REQUIRE(file.read() == createFileContent(16));
+    }
+
+    SECTION("view to mapped data") {
+        TemporaryFile file("HyperBufferMappedTest.bin", createFileContent(2*8));
+        HyperBufferMapped<float, 2> buffer(file.path(), MappedFile::Mode::CopyOnWrite, 2, 8);
+        HyperBufferView<float, 2> view(buffer);
+        view[1][7] = 0.5f;
+        REQUIRE(buffer[1][7] == 0.5f);
+        REQUIRE(BufferOperations::detail::isFlat(buffer));
+    }
+}
@@ -0,0 +1,105 @@
+//
+//  ╦ ╦┬ ┬┌─┐┌─┐┬─┐  ╔╗ ┬ ┬┌─┐┌─┐┌─┐┬─┐
+//  ╠═╣└┬┘├─┘├┤ ├┬┘  ╠╩╗│ │├┤ ├┤ ├┤ ├┬┘
+//  ╩ ╩ ┴ ┴  └─┘┴└─  ╚═╝└─┘└  └  └─┘┴└─
+//
+//  © 2023 Lorenz Bucher - all rights reserved
+//  https://github.com/Sidelobe/HyperBuffer
+
+#include "TestCommon.hpp"
+#include "MemorySentinel.hpp"
+
+#include <thread>
+
+#include "HyperBufferQueue.hpp"
+
+using namespace slb;
+
+TEST_CASE("HyperBufferQueue Tests")
+{
+    SECTION("single thread: slots are used in order") {
+        HyperBufferQueue<float, 2> queue(3, 2, 16);
+        REQUIRE(queue.capacity() == 3);
+        REQUIRE(queue.isEmpty());
+        REQUIRE(queue.acquireRead() == nullptr);
+
+        HyperBuffer<float, 2>* slots[3];
+        {   // no dynamic memory allocation
+            ScopedMemorySentinel sentinel;
+            for (int i=0; i < 3; ++i) {
+                slots[i] = queue.acquireWrite();
+                REQUIRE(slots[i] != nullptr);
+                REQUIRE(queue.acquireWrite() == slots[i]); // not published yet: same slot
+                (*slots[i])[1][15] = static_cast<float>(i);
+                queue.publish();
+            }
+            REQUIRE(queue.acquireWrite() == nullptr); // full
+            REQUIRE(queue.getNumReadable() == 3);
+
+            HyperBuffer<float, 2>* slot = queue.acquireRead();
+            REQUIRE(slot == slots[0]);
+            REQUIRE((*slot)[1][15] == 0.f);
+            queue.release();
+            REQUIRE(queue.acquireWrite() == slots[0]); // wraps around
+        }
+        REQUIRE(slots[0]->sizes() == std::array<int, 2>{2, 16});
+        REQUIRE(slots[1] != slots[0]);
+        REQUIRE(slots[2] != slots[1]);
+    }
+
+    SECTION("push & pop copies") {
+        HyperBufferQueue<int, 1> queue(2, 4);
+        HyperBuffer<int, 1> source(4);
+        HyperBuffer<int, 1> destination(4);
+        for (int i=0; i < 4; ++i) {
+            source[i] = i;
+        }
+        REQUIRE(queue.tryPush(source));
+        REQUIRE(queue.tryPush(source));
+        REQUIRE_FALSE(queue.tryPush(source));
+        REQUIRE(queue.tryPop(destination));
+        REQUIRE(destination[3] == 3);
+        REQUIRE(queue.tryPop(destination));
+        REQUIRE_FALSE(queue.tryPop(destination));
+        REQUIRE(queue.isEmpty());
+    }
+
+    SECTION("producer & consumer threads") {
+        constexpr int numBlocks = 10000;
+        HyperBufferQueue<int, 2> queue(4, 2, 32);
+
+        std::thread producer([&queue]() {
+            for (int block = 0; block < numBlocks; ) {
+                if (auto* slot = queue.acquireWrite()) {
+                    for (int ch=0; ch < 2; ++ch) {
+                        for (int i=0; i < 32; ++i) {
+                            (*slot)[ch][i] = block + ch + i;
+                        }
+                    }
+                    queue.publish();
+                    ++block;
+                } else {
+                    std::this_thread::yield();
+                }
+            }
+        });
+
+        int numCorrupted = 0;
+        for (int block = 0; block < numBlocks; ) {
+            if (auto* slot = queue.acquireRead()) {
+                for (int ch=0; ch < 2; ++ch) {
+                    for (int i=0; i < 32; ++i) {
+                        numCorrupted += ((*slot)[ch][i] != block + ch + i);
+                    }
+                }
+                queue.release();
+                ++block;
+            } else {
+                std::this_thread::yield();
+            }
+        }
+        producer.join();
+        REQUIRE(numCorrupted == 0);
+        REQUIRE(queue.isEmpty());
+    }
+}
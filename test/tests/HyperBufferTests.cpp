@@ -121,6 +121,8 @@ TEST_CASE("HyperBuffer Tests - Construction and Data Access")
         { // Verify all access operations do not allocate memory
             ScopedMemorySentinel sentinel;
             buffer[0][2] = -2;
+            buffer.at(1, 2) = -2;
+            auto subView = buffer.subView(1); UNUSED(subView);
             int d0 = buffer.size(0); UNUSED(d0);
             const int* dims = buffer.sizes().data(); UNUSED(dims);
             auto dimsArray = buffer.sizes(); UNUSED(dimsArray);
@@ -151,6 +153,9 @@ TEST_CASE("HyperBuffer Tests - Construction and Data Access")
         { // Verify all access operations do not allocate memory
             ScopedMemorySentinel sentinel;
             buffer[0][2][0] = -2;
+            buffer.at(1, 2, 6) = 666;
+            auto subView = buffer.subView(1); UNUSED(subView);
+            auto subView1D = buffer.subView(1, 2); UNUSED(subView1D);
             int d0 = buffer.size(0); UNUSED(d0);
             const int* dimsPtr = buffer.sizes().data(); UNUSED(dimsPtr);
             auto dimsArray = buffer.sizes(); UNUSED(dimsArray);
@@ -413,6 +418,9 @@ TEST_CASE("HyperBuffer: sub-buffer construction & at() access")
         buffer.at(0, 1, 5) = -13;
         REQUIRE(buffer.at(0, 1, 5) == -13);
         buffer.at(0, 1, 5) = 13; // restore original value
+        REQUIRE(&buffer.at(2, 1, 5) == &buffer[2][1][5]);
+        REQUIRE_THROWS(buffer.at(3, 0, 0)); // out of range
+        REQUIRE_THROWS(buffer.at(0, 3, 0));
         
         int subBufferIndex = 2;
         int subBufferIndex2 = 1;
@@ -441,11 +449,203 @@ TEST_CASE("HyperBuffer: sub-buffer construction & at() access")
         HyperBufferViewNC<int, 3> buffer(nonContiguousData, 3, 3, 8);
         fillWith3DSequence(buffer);
         verify(buffer);
-        
-        { // Creating a sub-buffer also does not allocate memory
+    }
+    
+    SECTION("sub-view of a sub-view") {
+        HyperBuffer<int, 4> buffer(2, 3, 3, 8);
+        for (int i=0; i < 2; ++i) {
+            auto subView = buffer.subView(i);
+            fillWith3DSequence(subView);
+        }
+        auto subView = buffer.subView(1);
+        verify(subView);
+        auto subSubView = subView.subView(2);
+        REQUIRE(subSubView.sizes() == std::array<int, 2>{3, 8});
+        REQUIRE(&subSubView[1][4] == &buffer[1][2][1][4]);
+        REQUIRE(subSubView.at(1, 4) == 2*3*8 + 8 + 4);
+    }
+    
+    SECTION("creating a sub-buffer does not allocate memory") {
+        HyperBuffer<int, 3> owning(3, 3, 8);
+        int dataRaw1 [3*3*8];
+        HyperBufferView<int, 3> view(dataRaw1, 3, 3, 8);
+        BUILD_NC_ON_STACK_3_3_8(nonContiguousData);
+        HyperBufferViewNC<int, 3> nonContiguous(nonContiguousData, 3, 3, 8);
+        {
             ScopedMemorySentinel sentinel;
-            auto subBuffer = buffer.subView(1);
-            UNUSED(subBuffer);
+            auto a = owning.subView(1);           UNUSED(a);
+            auto b = view.subView(1);             UNUSED(b);
+            auto c = nonContiguous.subView(1);    UNUSED(c);
+            auto aa = owning.subView(1, 2);       UNUSED(aa);
+            auto bb = view.subView(1, 2);         UNUSED(bb);
+            auto cc = nonContiguous.subView(1, 2); UNUSED(cc);
+            auto copy = a;                        UNUSED(copy);
+            owning.at(2, 1, 3) = 1;
+            view.at(2, 1, 3) = 1;
+            nonContiguous.at(2, 1, 3) = 1;
+        }
+    }
+}
+
+TEST_CASE("HyperBuffer: aligned data")
+{
+    auto isAligned = [](const void* pointer, std::size_t alignment)
+    {
+        return reinterpret_cast<std::uintptr_t>(pointer) % alignment == 0;
+    };
+    
+    SECTION("rows are aligned and padded") {
+        HyperBufferAligned<float, 3, 64> buffer(3, 2, 5);
+        REQUIRE(buffer.sizes() == std::array<int, 3>{3, 2, 5});
+        for (int k=0; k < buffer.size(0); ++k) {
+            for (int l=0; l < buffer.size(1); ++l) {
+                REQUIRE(isAligned(buffer[k][l], 64));
+                REQUIRE(buffer[k][l][4] == 0.f);
+            }
+        }
+        REQUIRE(buffer[0][1] - buffer[0][0] == 16); // 5 floats padded to 64 bytes
+    }
+    
+    SECTION("data access & sub-views") {
+        HyperBufferAligned<int, 3, 32> buffer(3, 3, 8);
+        fillWith3DSequence(buffer);
+        REQUIRE(buffer.at(2, 1, 7) == 2*3*8 + 1*8 + 7);
+        
+        HyperBufferAligned<int, 3, 32> oddBuffer(3, 3, 3);
+        fillWith3DSequence(oddBuffer);
+        REQUIRE(oddBuffer.at(2, 1, 2) == 2*3*3 + 1*3 + 2);
+        REQUIRE(oddBuffer[2][1][2] == 2*3*3 + 1*3 + 2);
+        auto subView = oddBuffer.subView(1);
+        REQUIRE(subView.sizes() == std::array<int, 2>{3, 3});
+        REQUIRE(subView[2][0] == 1*3*3 + 2*3);
+        REQUIRE(isAligned(subView[2], 32));
+        auto subView1D = oddBuffer.subView(2, 2);
+        REQUIRE(subView1D[1] == 2*3*3 + 2*3 + 1);
+        
+        // View from an aligned owning buffer
+        HyperBufferView<int, 3> view(oddBuffer);
+        REQUIRE(&view[2][1][2] == &oddBuffer[2][1][2]);
+        REQUIRE(view.at(1, 2, 0) == 1*3*3 + 2*3);
+    }
+    
+    SECTION("copy preserves alignment") {
+        HyperBufferAligned<double, 2, 64> buffer(4, 3);
+        buffer[3][2] = 3.5;
+        HyperBufferAligned<double, 2, 64> copy = buffer;
+        REQUIRE(copy[3][2] == 3.5);
+        REQUIRE(isAligned(copy[3], 64));
+        REQUIRE(copy[3] != buffer[3]);
+    }
+}
+
+TEST_CASE("StaticHyperBuffer")
+{
+    SECTION("construction & data access do not allocate") {
+        ScopedMemorySentinel sentinel;
+        StaticHyperBuffer<int, 3, 3, 8> buffer;
+        REQUIRE(buffer.sizes() == std::array<int, 3>{3, 3, 8});
+        REQUIRE(buffer.size(2) == 8);
+        REQUIRE(buffer[2][2][7] == 0); // value-initialized
+        fillWith3DSequence(buffer);
+        REQUIRE(buffer.at(2, 1, 5) == 2*3*8 + 8 + 5);
+        REQUIRE(&buffer.at(2, 1, 5) == &buffer[2][1][5]);
+        REQUIRE(buffer.data()[1][2][3] == 1*3*8 + 2*8 + 3);
+        
+        auto subView = buffer.subView(1);
+        REQUIRE(subView.sizes() == std::array<int, 2>{3, 8});
+        REQUIRE(subView.at(2, 3) == 1*3*8 + 2*8 + 3);
+        
+        StaticHyperBuffer<float, 4> buffer1D;
+        buffer1D[3] = 1.f;
+        REQUIRE(buffer1D.at(3) == 1.f);
+        REQUIRE(buffer1D.data() == &buffer1D[0]);
+    }
+    
+    SECTION("sub-buffers & const access") {
+        StaticHyperBuffer<int, 3, 3, 8> buffer;
+        fillWith3DSequence(buffer);
+        const auto& constBuffer = buffer;
+        REQUIRE(constBuffer.at(0, 0, 7) == 7);
+        REQUIRE(constBuffer.subView(2, 1)[3] == 2*3*8 + 8 + 3);
+        REQUIRE_THROWS(buffer.at(3, 0, 0));
+    }
+    
+    SECTION("copy & move re-connect pointers") {
+        StaticHyperBuffer<int, 2, 4> buffer;
+        buffer[1][3] = 13;
+        
+        StaticHyperBuffer<int, 2, 4> copy = buffer;
+        REQUIRE(copy[1][3] == 13);
+        REQUIRE(copy[1] != buffer[1]);
+        copy[1][3] = -1;
+        REQUIRE(buffer[1][3] == 13);
+        
+        copy = buffer;
+        REQUIRE(copy[1][3] == 13);
+        REQUIRE(copy[1] != buffer[1]);
+        
+        StaticHyperBuffer<int, 2, 4> moved = std::move(copy);
+        REQUIRE(moved[1][3] == 13);
+        REQUIRE(&moved[1][3] == &moved.at(1, 3));
+    }
+    
+    static_assert(sizeof(StaticHyperBuffer<float, 2, 512>) == 2*512*sizeof(float) + 2*sizeof(float*), "Stored inline");
+}
+
+TEST_CASE("HyperBuffer: single-block storage")
+{
+    SECTION("data access & sub-views") {
+        HyperBufferSingleBlock<int, 3> buffer(3, 3, 8);
+        REQUIRE(buffer.sizes() == std::array<int, 3>{3, 3, 8});
+        REQUIRE(buffer[2][2][7] == 0);
+        fillWith3DSequence(buffer);
+        REQUIRE(buffer.at(2, 1, 5) == 2*3*8 + 8 + 5);
+        REQUIRE(buffer.subView(1, 2)[3] == 1*3*8 + 2*8 + 3);
+        
+        // pointers are immediately followed by the data
+        auto blockStart = reinterpret_cast<const unsigned char*>(buffer.data());
+        auto dataStart = reinterpret_cast<const unsigned char*>(&buffer[0][0][0]);
+        REQUIRE(dataStart - blockStart == (3 + 3*3) * static_cast<int>(sizeof(int*)));
+        
+        HyperBufferView<int, 3> view(buffer);
+        REQUIRE(&view[2][1][4] == &buffer[2][1][4]);
+    }
+    
+    SECTION("aligned") {
+        HyperBufferSingleBlock<float, 2, 64> buffer(3, 5);
+        for (int i=0; i < buffer.size(0); ++i) {
+            REQUIRE(reinterpret_cast<std::uintptr_t>(buffer[i]) % 64 == 0);
+        }
+        REQUIRE(buffer[1] - buffer[0] == 16);
+        
+        HyperBufferSingleBlock<float, 1, 32> buffer1D(7);
+        REQUIRE(reinterpret_cast<std::uintptr_t>(buffer1D.data()) % 32 == 0);
+        buffer1D[6] = 6.f;
+        REQUIRE(buffer1D.at(6) == 6.f);
+    }
+    
+    SECTION("non-primitive data type") {
+        HyperBufferSingleBlock<std::string, 2> buffer(2, 3);
+        buffer[1][2] = "a string that is long enough to be allocated on the heap";
+        HyperBufferSingleBlock<std::string, 2> copy = buffer;
+        REQUIRE(copy[1][2] == buffer[1][2]);
+        HyperBufferSingleBlock<std::string, 2> smaller(1, 1);
+        smaller = copy;
+        REQUIRE(smaller.sizes() == std::array<int, 2>{2, 3});
+        REQUIRE(smaller.at(1, 2) == buffer[1][2]);
+    }
+    
+    SECTION("single allocation") {
+        BufferGeometry<3> geometry(3, 3, 8);
+        const auto blockSize = StoragePolicyOwningSingleBlock<int, 3>::getBlockSize(geometry);
+        REQUIRE(blockSize == (3 + 3*3) * sizeof(int*) + 3*3*8 * sizeof(int));
+        {
+            ScopedMemorySentinel sentinel(static_cast<int>(blockSize));
+            HyperBufferSingleBlock<int, 3> buffer(3, 3, 8);
+        }
+        {
+            ScopedMemorySentinel sentinel(static_cast<int>(blockSize) - 1);
+            REQUIRE_THROWS(HyperBufferSingleBlock<int, 3>(3, 3, 8));
         }
     }
 }
@@ -504,8 +704,8 @@ TEST_CASE("HyperBuffer: out of memory")
 TEST_CASE("HyperBuffer: memory allocation - precise verification")
 {
     BufferGeometry<3> bufferGeo(3, 3, 8);
-    int dataArraySizeBytes = bufferGeo.getRequiredDataArraySize() * sizeof(int);
-    int pointerArraySizeBytes = bufferGeo.getRequiredPointerArraySize() * sizeof(int*);
+    int dataArraySizeBytes = static_cast<int>(bufferGeo.getRequiredDataArraySize() * offset_type(sizeof(int)));
+    int pointerArraySizeBytes = static_cast<int>(bufferGeo.getRequiredPointerArraySize() * offset_type(sizeof(int*)));
 
     auto& sentinel = MemorySentinel::getInstance();
     MemorySentinel::setTransgressionBehaviour(MemorySentinel::TransgressionBehaviour::THROW_EXCEPTION);
@@ -0,0 +1,86 @@
+//
+//  ╦ ╦┬ ┬┌─┐┌─┐┬─┐  ╔╗ ┬ ┬┌─┐┌─┐┌─┐┬─┐
+//  ╠═╣└┬┘├─┘├┤ ├┬┘  ╠╩╗│ │├┤ ├┤ ├┤ ├┬┘
+//  ╩ ╩ ┴ ┴  └─┘┴└─  ╚═╝└─┘└  └  └─┘┴└─
+//
+//  © 2023 Lorenz Bucher - all rights reserved
+//  https://github.com/Sidelobe/HyperBuffer
+
+#include "TestCommon.hpp"
+#include "MemorySentinel.hpp"
+
+#include <thread>
+
+#include "HyperBufferTripleBuffer.hpp"
+
+using namespace slb;
+
+TEST_CASE("HyperBufferTripleBuffer Tests")
+{
+    SECTION("single thread: the reader gets the latest state") {
+        HyperBufferTripleBuffer<float, 3> state(2, 3, 4);
+        REQUIRE(state.getWriteBuffer().sizes() == std::array<int, 3>{2, 3, 4});
+        REQUIRE_FALSE(state.hasNewData());
+        const HyperBuffer<float, 3>* initial = &state.acquireRead();
+
+        {   // no dynamic memory allocation
+            ScopedMemorySentinel sentinel;
+            HyperBuffer<float, 3>* first = &state.getWriteBuffer();
+            REQUIRE(first != initial);
+            (*first)[1][2][3] = 1.f;
+            state.publish();
+            REQUIRE(state.hasNewData());
+            REQUIRE(&state.getWriteBuffer() != first);
+
+            state.getWriteBuffer()[1][2][3] = 2.f;
+            state.publish();
+            state.getWriteBuffer()[1][2][3] = 3.f; // not published
+
+            const HyperBuffer<float, 3>& latest = state.acquireRead();
+            REQUIRE(latest[1][2][3] == 2.f); // 1 was skipped
+            REQUIRE_FALSE(state.hasNewData());
+            REQUIRE(&state.acquireRead() == &latest); // nothing new: same buffer
+        }
+
+        HyperBuffer<float, 3> source(2, 3, 4);
+        source[0][0][0] = 5.f;
+        state.write(source);
+        REQUIRE(state.acquireRead()[0][0][0] == 5.f);
+    }
+
+    SECTION("writer & reader threads") {
+        constexpr int numStates = 10000;
+        HyperBufferTripleBuffer<int, 2> state(4, 64);
+
+        std::thread writer([&state]() {
+            for (int s = 1; s <= numStates; ++s) {
+                HyperBuffer<int, 2>& buffer = state.getWriteBuffer();
+                for (int i=0; i < 4; ++i) {
+                    for (int j=0; j < 64; ++j) {
+                        buffer[i][j] = s;
+                    }
+                }
+                state.publish();
+            }
+        });
+
+        int numTorn = 0;
+        int numOutOfOrder = 0;
+        int previous = 0;
+        while (previous != numStates) {
+            const HyperBuffer<int, 2>& buffer = state.acquireRead();
+            const int current = buffer[0][0];
+            for (int i=0; i < 4; ++i) {
+                for (int j=0; j < 64; ++j) {
+                    numTorn += (buffer[i][j] != current);
+                }
+            }
+            numOutOfOrder += (current < previous);
+            previous = current;
+            std::this_thread::yield();
+        }
+        writer.join();
+        REQUIRE(numTorn == 0);
+        REQUIRE(numOutOfOrder == 0);
+    }
+}
@@ -35,4 +35,8 @@ TEST_CASE("StdArrayOperations Tests")
 
     REQUIRE(shaveOffFirstElement(std::array<int, 4>{6, 5, 2, 3}) == std::array<int, 3>{5, 2, 3});
     REQUIRE(shaveOffFirstElement(std::array<int, 2>{5, 3}) == std::array<int, 1>{3});
+    
+    REQUIRE(removeElement(std::array<int, 4>{6, 5, 2, 3}, 0) == std::array<int, 3>{5, 2, 3});
+    REQUIRE(removeElement(std::array<int, 4>{6, 5, 2, 3}, 2) == std::array<int, 3>{6, 5, 3});
+    REQUIRE(removeElement(std::array<int, 4>{6, 5, 2, 3}, 3) == std::array<int, 3>{6, 5, 2});
 }
@@ -0,0 +1,182 @@
+//
+//  ╦ ╦┬ ┬┌─┐┌─┐┬─┐  ╔╗ ┬ ┬┌─┐┌─┐┌─┐┬─┐
+//  ╠═╣└┬┘├─┘├┤ ├┬┘  ╠╩╗│ │├┤ ├┤ ├┤ ├┬┘
+//  ╩ ╩ ┴ ┴  └─┘┴└─  ╚═╝└─┘└  └  └─┘┴└─
+//
+//  © 2023 Lorenz Bucher - all rights reserved
+//  https://github.com/Sidelobe/HyperBuffer
+
+#include "TestCommon.hpp"
+
+#include <cstdint>
+#include <vector>
+
+#include "HyperBuffer.hpp"
+#include "MemorySentinel.hpp"
+
+using namespace slb;
+
+namespace
+{
+/** Resource that counts the allocations it forwards to the new/delete resource */
+class CountingResource final : public MemoryResource
+{
+public:
+    int numAllocations = 0;
+    int numDeallocations = 0;
+    std::size_t numBytesInUse = 0;
+
+private:
+    void* doAllocate(std::size_t numBytes, std::size_t alignment) override
+    {
+        ++numAllocations;
+        numBytesInUse += numBytes;
+        return MemoryResources::getNewDeleteResource()->allocate(numBytes, alignment);
+    }
+    void doDeallocate(void* memory, std::size_t numBytes, std::size_t alignment) noexcept override
+    {
+        ++numDeallocations;
+        numBytesInUse -= numBytes;
+        MemoryResources::getNewDeleteResource()->deallocate(memory, numBytes, alignment);
+    }
+    bool doIsEqual(const MemoryResource& other) const noexcept override { return this == &other; }
+};
+} // namespace
+
+TEST_CASE("MemoryResource Tests")
+{
+    SECTION("new/delete & null resource") {
+        MemoryResource* newDelete = MemoryResources::getNewDeleteResource();
+        for (std::size_t alignment : { 1, 16, 64, 4096 }) {
+            void* memory = newDelete->allocate(100, alignment);
+            REQUIRE(reinterpret_cast<std::uintptr_t>(memory) % alignment == 0);
+            newDelete->deallocate(memory, 100, alignment);
+        }
+        REQUIRE(*newDelete == *MemoryResources::getNewDeleteResource());
+        REQUIRE(*newDelete != *MemoryResources::getNullResource());
+        REQUIRE_THROWS_AS(MemoryResources::getNullResource()->allocate(1), std::bad_alloc);
+    }
+
+    SECTION("default resource") {
+        REQUIRE(MemoryResources::getDefaultResource() == MemoryResources::getNewDeleteResource());
+        CountingResource counter;
+        MemoryResource* previous = MemoryResources::setDefaultResource(&counter);
+        REQUIRE(previous == MemoryResources::getNewDeleteResource());
+        {
+            HyperBuffer<float, 2> buffer(3, 4);
+            REQUIRE(counter.numAllocations == 2); // pointers & data
+        }
+        REQUIRE(counter.numBytesInUse == 0);
+        MemoryResources::setDefaultResource(nullptr);
+        REQUIRE(MemoryResources::getDefaultResource() == MemoryResources::getNewDeleteResource());
+    }
+
+    SECTION("monotonic buffer resource") {
+        alignas(64) unsigned char arena[256];
+        MonotonicBufferResource resource(arena, sizeof(arena), MemoryResources::getNullResource());
+
+        void* a = resource.allocate(10, 1);
+        void* b = resource.allocate(16, 64);
+        REQUIRE(a == arena);
+        REQUIRE(b == arena + 64);
+        resource.deallocate(b, 16, 64); // no-op
+        void* c = resource.allocate(100, 4);
+        REQUIRE(c == arena + 80);
+
+        // arena exhausted & upstream refuses
+        REQUIRE_THROWS_AS(resource.allocate(100, 4), std::bad_alloc);
+
+        resource.release();
+        REQUIRE(resource.allocate(10, 1) == arena);
+    }
+
+    SECTION("monotonic buffer resource: upstream chunks") {
+        CountingResource upstream;
+        {
+            unsigned char arena[64];
+            MonotonicBufferResource resource(arena, sizeof(arena), &upstream);
+            resource.allocate(48);
+            REQUIRE(upstream.numAllocations == 0);
+            void* overflow = resource.allocate(500, 16);
+            REQUIRE(upstream.numAllocations == 1);
+            REQUIRE(reinterpret_cast<std::uintptr_t>(overflow) % 16 == 0);
+            resource.allocate(16);
+            REQUIRE(upstream.numAllocations == 1); // served from the same chunk
+            resource.release();
+            REQUIRE(upstream.numBytesInUse == 0);
+
+            MonotonicBufferResource noInitialBuffer(&upstream);
+            noInitialBuffer.allocate(8);
+            REQUIRE(upstream.numAllocations == 2);
+        }
+        REQUIRE(upstream.numBytesInUse == 0); // released on destruction
+    }
+}
+
+TEST_CASE("HyperBuffer: memory resources")
+{
+    alignas(64) unsigned char arena[4096];
+    MonotonicBufferResource resource(arena, sizeof(arena), MemoryResources::getNullResource());
+    auto isInArena = [&arena](const void* p) { return p >= arena && p < arena + sizeof(arena); };
+
+    SECTION("owning") {
+        ScopedMemorySentinel sentinel; // the global heap is never touched
+        HyperBuffer<float, 3> buffer(&resource, 2, 3, 4);
+        REQUIRE(isInArena(buffer.data()));
+        REQUIRE(isInArena(&buffer[1][2][3]));
+        buffer[1][2][3] = 1.f;
+
+        HyperBuffer<float, 3> copy(buffer); // copies draw from the same resource
+        REQUIRE(isInArena(&copy[1][2][3]));
+        REQUIRE(copy[1][2][3] == 1.f);
+
+        HyperBufferAligned<float, 2, 64> aligned(&resource, 3, 5);
+        REQUIRE(isInArena(aligned[2]));
+        REQUIRE(reinterpret_cast<std::uintptr_t>(aligned[2]) % 64 == 0);
+    }
+
+    SECTION("single-block") {
+        ScopedMemorySentinel sentinel;
+        HyperBufferSingleBlock<int, 3, 32> buffer(&resource, 2, 3, 4);
+        REQUIRE(isInArena(buffer.data()));
+        REQUIRE(isInArena(&buffer[1][2][3]));
+        HyperBufferSingleBlock<int, 3, 32> copy(buffer);
+        REQUIRE(isInArena(copy.data()));
+    }
+
+    SECTION("view") {
+        std::vector<int> data(2*3*4);
+        ScopedMemorySentinel sentinel;
+        HyperBufferView<int, 3> view(&resource, data.data(), 2, 3, 4);
+        REQUIRE(isInArena(view.data()));
+        REQUIRE(&view[1][2][3] == &data[23]);
+
+        HyperBufferView<int, 3> viewFromGeometry(&resource, data.data(), BufferGeometry<3>(2, 3, 4));
+        REQUIRE(isInArena(viewFromGeometry.data()));
+        REQUIRE(&viewFromGeometry[1][2][3] == &data[23]);
+    }
+
+    SECTION("assignment") {
+        CountingResource counter;
+        HyperBuffer<int, 2> source(&counter, 3, 4);
+        source[2][3] = 42;
+        const int* sourceData = &source[0][0];
+        REQUIRE(counter.numAllocations == 2);
+
+        // copy-assignment keeps the resource of the target
+        HyperBuffer<int, 2> copyTarget(&resource, 1, 1);
+        copyTarget = source;
+        REQUIRE(isInArena(&copyTarget[2][3]));
+        REQUIRE(copyTarget[2][3] == 42);
+
+        // move-assignment takes over the memory (and resource) of the source
+        HyperBuffer<int, 2> moveTarget(&resource, 1, 1);
+        {
+            ScopedMemorySentinel sentinel;
+            moveTarget = std::move(source);
+        }
+        REQUIRE(&moveTarget[0][0] == sourceData);
+        REQUIRE(moveTarget[2][3] == 42);
+        REQUIRE(counter.numAllocations == 2);
+    }
+}
@@ -0,0 +1,133 @@
+//
+//  ╦ ╦┬ ┬┌─┐┌─┐┬─┐  ╔╗ ┬ ┬┌─┐┌─┐┌─┐┬─┐
+//  ╠═╣└┬┘├─┘├┤ ├┬┘  ╠╩╗│ │├┤ ├┤ ├┤ ├┬┘
+//  ╩ ╩ ┴ ┴  └─┘┴└─  ╚═╝└─┘└  └  └─┘┴└─
+//
+//  © 2023 Lorenz Bucher - all rights reserved
+//  https://github.com/Sidelobe/HyperBuffer
+
+#include "TestCommon.hpp"
+
+#include <cstdio>
+#include <sstream>
+#include <vector>
+
+#include "NpyFormat.hpp"
+
+using namespace slb;
+
+namespace
+{
+/** @returns a .npy file (version 1.0) with the given header dictionary and payload, as NumPy writes it */
+template<typename T>
+std::vector<double> createNpy(const std::string& dictionary, const std::vector<T>& payload, std::size_t& size)
+{
+    std::string header = dictionary;
+    header.append(64 - (10 + header.size() + 1) % 64, ' ');
+    header += '\n';
+    std::string bytes = std::string("\x93NUMPY\x01\x00", 8) + static_cast<char>(header.size() & 0xFF) +
+                        static_cast<char>(header.size() >> 8) + header;
+    bytes.append(reinterpret_cast<const char*>(payload.data()), payload.size() * sizeof(T));
+
+    size = bytes.size();
+    std::vector<double> storage(size / sizeof(double) + 1); // aligned to (at least) the data type
+    std::memcpy(storage.data(), bytes.data(), size);
+    return storage;
+}
+} // namespace
+
+TEST_CASE("Npy Tests")
+{
+    SECTION("parse NumPy output: zero-copy") {
+        // np.save(f, np.arange(6, dtype=np.float32).reshape(2, 3))
+        std::size_t size;
+        auto npy = createNpy("{'descr': '<f4', 'fortran_order': False, 'shape': (2, 3), }",
+                             std::vector<float>{ 0, 1, 2, 3, 4, 5 }, size);
+        REQUIRE(size == 128 + 6 * sizeof(float));
+
+        auto view = Npy::parse<float, 2>(npy.data(), size);
+        REQUIRE(view.sizes() == std::array<int, 2>{2, 3});
+        REQUIRE(view[1][2] == 5.f);
+        REQUIRE(&view[0][0] == reinterpret_cast<float*>(reinterpret_cast<char*>(npy.data()) + 128)); // in place
+
+        const auto& constNpy = npy;
+        auto constView = Npy::parse<const float, 2>(constNpy.data(), size);
+        REQUIRE(constView[0][1] == 1.f);
+
+        auto int16 = createNpy("{'descr': '<i2', 'fortran_order': False, 'shape': (4,), }", std::vector<std::int16_t>{ 1, -2, 3, -4 }, size);
+        REQUIRE(Npy::parse<std::int16_t, 1>(int16.data(), size)[3] == -4);
+        auto bytes = createNpy("{'descr': '|u1', 'fortran_order': False, 'shape': (1, 1, 3), }", std::vector<std::uint8_t>{ 7, 8, 9 }, size);
+        REQUIRE(Npy::parse<std::uint8_t, 3>(bytes.data(), size)[0][0][2] == 9);
+    }
+
+    SECTION("invalid headers") {
+        std::size_t size;
+        auto npy = createNpy("{'descr': '<f4', 'fortran_order': False, 'shape': (2, 3), }", std::vector<float>(6), size);
+        REQUIRE_THROWS(Npy::parse<double, 2>(npy.data(), size));
+        REQUIRE_THROWS(Npy::parse<std::int32_t, 2>(npy.data(), size));
+        REQUIRE_THROWS(Npy::parse<float, 3>(npy.data(), size));
+        REQUIRE_THROWS(Npy::parse<float, 1>(npy.data(), size));
+        REQUIRE_THROWS(Npy::parse<float, 2>(npy.data(), size - 1));
+
+        auto fortran = createNpy("{'descr': '<f4', 'fortran_order': True, 'shape': (2, 3), }", std::vector<float>(6), size);
+        REQUIRE_THROWS(Npy::parse<float, 2>(fortran.data(), size));
+        auto bigEndian = createNpy("{'descr': '>f4', 'fortran_order': False, 'shape': (6,), }", std::vector<float>(6), size);
+        REQUIRE_THROWS(Npy::parse<float, 1>(bigEndian.data(), size));
+        auto empty = createNpy("{'descr': '<f4', 'fortran_order': False, 'shape': (0, 3), }", std::vector<float>(), size);
+        REQUIRE_THROWS(Npy::parse<float, 2>(empty.data(), size));
+        REQUIRE_THROWS(Npy::parse<float, 2>(npy.data(), 9));
+    }
+
+    SECTION("write: identical to NumPy output") {
+        HyperBuffer<float, 2> buffer(2, 3);
+        for (int i=0; i < 6; ++i) {
+            buffer[i / 3][i % 3] = static_cast<float>(i);
+        }
+        std::ostringstream stream;
+        Npy::write(buffer, stream);
+
+        std::size_t size;
+        auto npy = createNpy("{'descr': '<f4', 'fortran_order': False, 'shape': (2, 3), }",
+                             std::vector<float>{ 0, 1, 2, 3, 4, 5 }, size);
+        REQUIRE(stream.str() == std::string(reinterpret_cast<const char*>(npy.data()), size));
+
+        HyperBuffer<double, 1> buffer1D(3);
+        std::ostringstream stream1D;
+        Npy::write(buffer1D, stream1D);
+        REQUIRE(stream1D.str().find("'shape': (3,), }") != std::string::npos);
+    }
+
+    SECTION("round trip: padded & non-contiguous, memory-mapped") {
+        HyperBufferAligned<std::int32_t, 3, 64> padded(2, 3, 5);
+        std::vector<std::int32_t> channel0(5), channel1(5);
+        std::int32_t* channels[] = { channel0.data(), channel1.data() };
+        HyperBufferViewNC<std::int32_t, 2> nonContiguous(channels, 2, 5);
+        for (int i=0; i < 2; ++i) {
+            for (int k=0; k < 5; ++k) {
+                nonContiguous[i][k] = -(i * 10 + k);
+                for (int j=0; j < 3; ++j) {
+                    padded[i][j][k] = i * 100 + j * 10 + k;
+                }
+            }
+        }
+
+        const std::string path = "NpyTest.npy";
+        Npy::writeFile(padded, path);
+        {
+            auto loaded = Npy::readFile<const std::int32_t, 3>(path);
+            REQUIRE(loaded.sizes() == std::array<int, 3>{2, 3, 5});
+            REQUIRE(loaded[1][2][4] == 124);
+            REQUIRE(loaded[0][1][0] == 10);
+        }
+        Npy::writeFile(nonContiguous, path);
+        {
+            auto loaded = Npy::readFile<std::int32_t, 2>(path); // copy-on-write
+            REQUIRE(loaded[1][4] == -14);
+            loaded[1][4] = 0;
+            REQUIRE(Npy::readFile<const std::int32_t, 2>(path)[1][4] == -14);
+            REQUIRE_THROWS(Npy::readFile<float, 2>(path));
+        }
+        std::remove(path.c_str());
+        REQUIRE_THROWS(Npy::readFile<float, 2>(path));
+    }
+}
@@ -0,0 +1,170 @@
+//
+//  ╦ ╦┬ ┬┌─┐┌─┐┬─┐  ╔╗ ┬ ┬┌─┐┌─┐┌─┐┬─┐
+//  ╠═╣└┬┘├─┘├┤ ├┬┘  ╠╩╗│ │├┤ ├┤ ├┤ ├┬┘
+//  ╩ ╩ ┴ ┴  └─┘┴└─  ╚═╝└─┘└  └  └─┘┴└─
+//
+//  © 2023 Lorenz Bucher - all rights reserved
+//  https://github.com/Sidelobe/HyperBuffer
+
+#include "TestCommon.hpp"
+#include "MemorySentinel.hpp"
+
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include "Reductions.hpp"
+
+using namespace slb;
+
+namespace
+{
+/** value = i*100 + j*10 + k, negated for odd k */
+template<typename B>
+void fillWithSequence(B& buffer)
+{
+    for (int i=0; i < buffer.size(0); ++i) {
+        for (int j=0; j < buffer.size(1); ++j) {
+            for (int k=0; k < buffer.size(2); ++k) {
+                buffer[i][j][k] = static_cast<float>((k % 2 ? -1 : 1) * (i * 100 + j * 10 + k));
+            }
+        }
+    }
+}
+} // namespace
+
+TEST_CASE("SimdKernels Reduction Tests")
+{
+    std::vector<float> values(37);
+    for (std::size_t i=0; i < values.size(); ++i) {
+        values[i] = static_cast<float>(i) - 20.f;
+    }
+    const offset_type n = static_cast<offset_type>(values.size());
+    REQUIRE(SimdKernels::sum(values.data(), n) == 666.f - 740.f);
+    REQUIRE(SimdKernels::minimum(values.data(), n) == -20.f);
+    REQUIRE(SimdKernels::maximum(values.data(), n) == 16.f);
+    REQUIRE(SimdKernels::peak(values.data(), n) == 20.f);
+    REQUIRE(SimdKernels::sumOfSquares(values.data(), 3) == 400.f + 361.f + 324.f);
+
+    // pairwise summation: a naive float sum of 2^20 * 0.1 is off by more than 1000
+    std::vector<float> smallValues(1 << 20, 0.1f);
+    const float sum = SimdKernels::sum(smallValues.data(), static_cast<offset_type>(smallValues.size()));
+    REQUIRE(std::abs(sum - 104857.6f) < 1.f);
+
+    const int integers[] = { 3, -7, 5 };
+    REQUIRE(SimdKernels::peak(integers, 3) == 7);
+    REQUIRE(SimdKernels::sum(integers, 3) == 1);
+
+    // NaN propagates, wherever it is: in any lane of the vector body or in the tail
+    for (offset_type i=0; i < n; ++i) {
+        std::vector<float> withNaN(values);
+        withNaN[i] = std::numeric_limits<float>::quiet_NaN();
+        REQUIRE(std::isnan(SimdKernels::minimum(withNaN.data(), n)));
+        REQUIRE(std::isnan(SimdKernels::maximum(withNaN.data(), n)));
+        REQUIRE(std::isnan(SimdKernels::peak(withNaN.data(), n)));
+    }
+}
+
+TEST_CASE("Reductions Tests")
+{
+    HyperBuffer<float, 3> buffer(2, 3, 5);
+    fillWithSequence(buffer);
+
+    SECTION("entire buffer") {
+        HyperBufferAligned<float, 3, 32> padded(2, 3, 5);
+        fillWithSequence(padded);
+        for (int run = 0; run < 2; ++run) {
+            const float expectedSum = 360.f + 6 * 2.f; // every row: i*100 + j*10 + (0 - 1 + 2 - 3 + 4)
+            REQUIRE(Reductions::sum(buffer) == expectedSum);
+            REQUIRE(Reductions::sum(padded) == expectedSum);
+            REQUIRE(Reductions::minimum(padded) == -123.f);
+            REQUIRE(Reductions::maximum(buffer) == 124.f);
+            REQUIRE(Reductions::peak(padded) == 124.f);
+            REQUIRE(Reductions::mean(buffer) == Approx(expectedSum / 30.f));
+            fillWithSequence(buffer);
+        }
+
+        HyperBuffer<double, 1> constant(1000);
+        BufferOperations::fill(constant, -2.0);
+        REQUIRE(Reductions::rms(constant) == 2.0);
+        REQUIRE(Reductions::mean(constant) == -2.0);
+    }
+
+    SECTION("along an axis") {
+        auto peakPerRow = Reductions::peak(buffer, 2);
+        REQUIRE(peakPerRow.sizes() == std::array<int, 2>{2, 3});
+        REQUIRE(peakPerRow[1][2] == 124.f);
+        REQUIRE(peakPerRow[0][1] == 14.f);
+
+        auto sumOverOuter = Reductions::sum(buffer, 0);
+        REQUIRE(sumOverOuter.sizes() == std::array<int, 2>{3, 5});
+        REQUIRE(sumOverOuter[2][3] == -(23.f + 123.f));
+
+        auto maxOverMiddle = Reductions::maximum(buffer, 1);
+        REQUIRE(maxOverMiddle.sizes() == std::array<int, 2>{2, 5});
+        REQUIRE(maxOverMiddle[1][4] == 124.f);
+        REQUIRE(maxOverMiddle[1][3] == -103.f);
+        REQUIRE(Reductions::minimum(buffer, 1)[1][3] == -123.f);
+
+        HyperBuffer<float, 2> channels(2, 4);
+        channels[0][0] = 3.f; channels[0][1] = -4.f; channels[0][2] = 0.f; channels[0][3] = 0.f;
+        channels[1][0] = 1.f; channels[1][1] = 1.f; channels[1][2] = 1.f; channels[1][3] = 1.f;
+        HyperBuffer<float, 1> meters(2);
+        {   // into a given result: no dynamic memory allocation
+            ScopedMemorySentinel sentinel;
+            Reductions::rms(meters, channels, 1);
+        }
+        REQUIRE(meters[0] == 2.5f);
+        REQUIRE(meters[1] == 1.f);
+        Reductions::mean(meters, channels, 1);
+        REQUIRE(meters[0] == -0.25f);
+        REQUIRE(Reductions::mean(channels, 0)[1] == -1.5f);
+
+        HyperBuffer<float, 1> wrongSize(3);
+        REQUIRE_THROWS(Reductions::peak(wrongSize, channels, 1));
+        REQUIRE_THROWS(Reductions::peak(channels, 2));
+    }
+
+    SECTION("non-contiguous") {
+        std::vector<float> left { 1.f, -5.f, 2.f }, right { 0.5f, 4.f, -1.f };
+        float* channelPointers[] = { left.data(), right.data() };
+        HyperBufferViewNC<float, 2> nonContiguous(channelPointers, 2, 3);
+        REQUIRE(Reductions::peak(nonContiguous) == 5.f);
+        REQUIRE(Reductions::sum(nonContiguous) == 1.5f);
+        REQUIRE(Reductions::peak(nonContiguous, 1)[1] == 4.f);
+        REQUIRE(Reductions::maximum(nonContiguous, 0)[1] == 4.f);
+
+        left[2] = std::numeric_limits<float>::quiet_NaN();
+        REQUIRE(std::isnan(Reductions::minimum(nonContiguous)));
+        REQUIRE(std::isnan(Reductions::peak(nonContiguous, 1)[0]));
+        REQUIRE(Reductions::peak(nonContiguous, 1)[1] == 4.f);
+        REQUIRE(std::isnan(Reductions::maximum(nonContiguous, 0)[2]));
+    }
+
+    SECTION("parallel") {
+        ThreadPool pool(3);
+        HyperBuffer<double, 2> large(5, 10007);
+        for (int i=0; i < 5; ++i) {
+            for (int j=0; j < 10007; ++j) {
+                large[i][j] = (j == 5000 && i == 3) ? -7.0 : 1.0;
+            }
+        }
+        REQUIRE(Reductions::sum(large, pool) == Reductions::sum(large));
+        REQUIRE(Reductions::sum(large, pool) == 5 * 10007 - 8);
+        REQUIRE(Reductions::peak(large, pool) == 7.0);
+        REQUIRE(Reductions::minimum(large, pool) == -7.0);
+        REQUIRE(Reductions::maximum(large, pool) == 1.0);
+        REQUIRE(Reductions::mean(large, pool) == Approx(Reductions::mean(large)));
+        REQUIRE(Reductions::rms(large, pool) == Approx(Reductions::rms(large)));
+
+        std::vector<double> rows[5];
+        double* rowPointers[5];
+        for (int i=0; i < 5; ++i) {
+            rows[i].assign(100, static_cast<double>(i));
+            rowPointers[i] = rows[i].data();
+        }
+        HyperBufferViewNC<double, 2> nonContiguous(rowPointers, 5, 100);
+        REQUIRE(Reductions::sum(nonContiguous, pool) == 1000.0);
+        REQUIRE(Reductions::peak(nonContiguous, pool) == 4.0);
+    }
+}
@@ -0,0 +1,134 @@
+//
+//  ╦ ╦┬ ┬┌─┐┌─┐┬─┐  ╔╗ ┬ ┬┌─┐┌─┐┌─┐┬─┐
+//  ╠═╣└┬┘├─┘├┤ ├┬┘  ╠╩╗│ │├┤ ├┤ ├┤ ├┬┘
+//  ╩ ╩ ┴ ┴  └─┘┴└─  ╚═╝└─┘└  └  └─┘┴└─
+//
+//  © 2023 Lorenz Bucher - all rights reserved
+//  https://github.com/Sidelobe/HyperBuffer
+
+#include "TestCommon.hpp"
+#include "MemorySentinel.hpp"
+
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include "SampleFormat.hpp"
+
+using namespace slb;
+
+TEST_CASE("SampleFormat Tests")
+{
+    SECTION("int16: scaling, rounding & clipping") {
+        const std::vector<std::int16_t> samples { -32768, -16384, 0, 1, 16384, 32767, -1, 2, 3 };
+        std::vector<float> floats(samples.size());
+        SampleFormat::toFloat(floats.data(), samples.data(), static_cast<offset_type>(samples.size()));
+        REQUIRE(floats[0] == -1.f);
+        REQUIRE(floats[1] == -0.5f);
+        REQUIRE(floats[4] == 0.5f);
+        REQUIRE(floats[8] == 3.f / 32768.f);
+
+        std::vector<std::int16_t> roundTrip(samples.size());
+        SampleFormat::fromFloat(roundTrip.data(), floats.data(), static_cast<offset_type>(floats.size()));
+        REQUIRE(roundTrip == samples);
+
+        // vector and scalar path (the last sample): same results
+        const std::vector<float> outOfRange { 1.5f, -2.f, std::numeric_limits<float>::quiet_NaN(), 0.25f / 32768.f,
+                                              1.5f, -2.f, std::numeric_limits<float>::quiet_NaN(), 0.25f / 32768.f, 1.f };
+        std::vector<std::int16_t> clipped(outOfRange.size());
+        SampleFormat::fromFloat(clipped.data(), outOfRange.data(), static_cast<offset_type>(outOfRange.size()));
+        REQUIRE(clipped == std::vector<std::int16_t>{ 32767, -32768, -32768, 0, 32767, -32768, -32768, 0, 32767 });
+    }
+
+    SECTION("int24 & int32") {
+        const std::vector<std::int32_t> values { -8388608, -1, 0, 1, 8388607 };
+        std::vector<SampleFormat::Int24> samples24(values.size());
+        for (std::size_t i=0; i < values.size(); ++i) {
+            SampleFormat::Traits<SampleFormat::Int24>::write(samples24[i], values[i]);
+        }
+        REQUIRE(samples24[1].bytes[2] == 0xFF);
+        std::vector<float> floats(values.size());
+        SampleFormat::toFloat(floats.data(), samples24.data(), 5);
+        REQUIRE(floats[0] == -1.f);
+        REQUIRE(floats[1] == -1.f / 8388608.f);
+        floats[4] = 2.f;
+        SampleFormat::fromFloat(samples24.data(), floats.data(), 5);
+        for (std::size_t i=0; i < values.size(); ++i) {
+            REQUIRE(SampleFormat::Traits<SampleFormat::Int24>::read(samples24[i]) == values[i]);
+        }
+
+        const std::vector<std::int32_t> samples32 { std::numeric_limits<std::int32_t>::min(), -65536, 0, 1 << 30, 256 };
+        std::vector<float> floats32(samples32.size());
+        SampleFormat::toFloat(floats32.data(), samples32.data(), 5);
+        REQUIRE(floats32[0] == -1.f);
+        REQUIRE(floats32[3] == 0.5f);
+        floats32[1] = 1.f; // clipped
+        floats32[2] = std::numeric_limits<float>::quiet_NaN();
+        std::vector<std::int32_t> roundTrip(samples32.size());
+        SampleFormat::fromFloat(roundTrip.data(), floats32.data(), 5);
+        REQUIRE(roundTrip == std::vector<std::int32_t>{ std::numeric_limits<std::int32_t>::min(), 2147483520,
+                                                        std::numeric_limits<std::int32_t>::min(), 1 << 30, 256 });
+    }
+
+    SECTION("dither") {
+        std::vector<float> silence(1001, 0.f);
+        std::vector<std::int16_t> dithered(silence.size());
+        SampleFormat::TriangularDither dither;
+        SampleFormat::fromFloat(dithered.data(), silence.data(), static_cast<offset_type>(silence.size()), &dither);
+        int numNonZero = 0;
+        for (auto sample : dithered) {
+            REQUIRE(std::abs(sample) <= 1);
+            numNonZero += (sample != 0);
+        }
+        REQUIRE(numNonZero > 100);
+        REQUIRE(numNonZero < 900);
+
+        // reproducible: vector and scalar path draw the random numbers in order
+        SampleFormat::TriangularDither sameDither;
+        std::vector<std::int16_t> scalar(silence.size());
+        for (std::size_t i=0; i < silence.size(); ++i) {
+            SampleFormat::fromFloat(&scalar[i], &silence[i], 1, &sameDither);
+        }
+        REQUIRE(scalar == dithered);
+    }
+
+    SECTION("HyperBuffers: all storage policies, fused with (de-)interleaving") {
+        const int numChannels = GENERATE(1, 2, 3, 6, 2053);
+        const int numFrames = (numChannels > 1024) ? 5 : 1500; // multiple chunks (per frame, for many channels)
+        std::vector<std::int16_t> interleaved(static_cast<std::size_t>(numChannels * numFrames));
+        for (std::size_t i=0; i < interleaved.size(); ++i) {
+            interleaved[i] = static_cast<std::int16_t>(static_cast<int>(i % 65536) - 32768);
+        }
+
+        HyperBuffer<float, 2> buffer(numChannels, numFrames);
+        {   // no dynamic memory allocation
+            ScopedMemorySentinel sentinel;
+            SampleFormat::deinterleaveToFloat(buffer, interleaved.data());
+        }
+        const int ch = numChannels - 1;
+        const int frame = numFrames - 1;
+        REQUIRE(buffer[ch][frame] == static_cast<float>(interleaved[static_cast<std::size_t>(frame * numChannels + ch)]) / 32768.f);
+
+        std::vector<std::int16_t> result(interleaved.size());
+        SampleFormat::interleaveFromFloat(result.data(), buffer);
+        REQUIRE(result == interleaved);
+
+        std::vector<std::vector<float>> rows(static_cast<std::size_t>(numChannels), std::vector<float>(numFrames));
+        std::vector<float*> rowPointers;
+        for (auto& row : rows) {
+            rowPointers.push_back(row.data());
+        }
+        HyperBufferViewNC<float, 2> nonContiguous(rowPointers.data(), numChannels, numFrames);
+        SampleFormat::deinterleaveToFloat(nonContiguous, interleaved.data());
+        REQUIRE(rows[static_cast<std::size_t>(ch)][static_cast<std::size_t>(frame)] == buffer[ch][frame]);
+        SampleFormat::toFloat(nonContiguous, interleaved.data()); // channel by channel
+        std::vector<std::int16_t> planar(interleaved.size());
+        SampleFormat::fromFloat(planar.data(), nonContiguous);
+        REQUIRE(planar == interleaved);
+
+        std::vector<float> data(interleaved.size());
+        HyperBufferView<float, 2> view(data.data(), numChannels, numFrames);
+        SampleFormat::toFloat(view, interleaved.data());
+        REQUIRE(data.back() == static_cast<float>(interleaved.back()) / 32768.f);
+    }
+}
@@ -0,0 +1,140 @@
+//
+//  ╦ ╦┬ ┬┌─┐┌─┐┬─┐  ╔╗ ┬ ┬┌─┐┌─┐┌─┐┬─┐
+//  ╠═╣└┬┘├─┘├┤ ├┬┘  ╠╩╗│ │├┤ ├┤ ├┤ ├┬┘
+//  ╩ ╩ ┴ ┴  └─┘┴└─  ╚═╝└─┘└  └  └─┘┴└─
+//
+//  © 2023 Lorenz Bucher - all rights reserved
+//  https://github.com/Sidelobe/HyperBuffer
+
+#include "TestCommon.hpp"
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#include "Serialization.hpp"
+
+using namespace slb;
+
+namespace
+{
+template<typename B>
+void fillWithSequence(B& buffer)
+{
+    for (int i=0; i < buffer.size(0); ++i) {
+        for (int j=0; j < buffer.size(1); ++j) {
+            for (int k=0; k < buffer.size(2); ++k) {
+                buffer[i][j][k] = static_cast<float>(i * 100 + j * 10 + k);
+            }
+        }
+    }
+}
+
+template<typename A, typename B>
+bool haveEqualElements(const A& a, const B& b)
+{
+    if (a.sizes() != b.sizes()) {
+        return false;
+    }
+    for (int i=0; i < a.size(0); ++i) {
+        for (int j=0; j < a.size(1); ++j) {
+            for (int k=0; k < a.size(2); ++k) {
+                if (a[i][j][k] != b[i][j][k]) {
+                    return false;
+                }
+            }
+        }
+    }
+    return true;
+}
+} // namespace
+
+TEST_CASE("Serialization Tests")
+{
+    HyperBuffer<float, 3> buffer(2, 3, 5);
+    fillWithSequence(buffer);
+
+    SECTION("memory blob: zero-copy load") {
+        const std::size_t size = Serialization::getSerializedSize(buffer);
+        REQUIRE(size == 64 + 2*3*5 * sizeof(float)); // header + extents, padded to the data alignment
+        std::vector<double> storage(size / sizeof(double) + 1); // aligned to (at least) the data type
+        REQUIRE(Serialization::serialize(buffer, storage.data(), size) == size);
+
+        auto view = Serialization::deserialize<float, 3>(storage.data(), size);
+        REQUIRE(haveEqualElements(view, buffer));
+        REQUIRE(&view[0][0][0] == reinterpret_cast<float*>(reinterpret_cast<char*>(storage.data()) + 64)); // in place
+
+        const std::vector<double>& constStorage = storage;
+        auto constView = Serialization::deserialize<const float, 3>(constStorage.data(), size, false);
+        REQUIRE(constView[1][2][4] == 124.f);
+    }
+
+    SECTION("padded rows are preserved") {
+        HyperBufferAligned<float, 3, 32> padded(2, 3, 5);
+        fillWithSequence(padded);
+        const std::size_t size = Serialization::getSerializedSize(padded);
+        REQUIRE(size == 64 + 2*3*8 * sizeof(float));
+        std::vector<double> storage(size / sizeof(double));
+        Serialization::serialize(padded, storage.data(), size);
+
+        auto view = Serialization::deserialize<float, 3>(storage.data(), size);
+        REQUIRE(haveEqualElements(view, padded));
+        REQUIRE(view.stridedView().strides() == padded.stridedView().strides());
+    }
+
+    SECTION("sub-view") {
+        auto subView = buffer.subView(1);
+        std::vector<double> storage(Serialization::getSerializedSize(subView) / sizeof(double) + 1);
+        Serialization::serialize(subView, storage.data(), storage.size() * sizeof(double));
+        auto view = Serialization::deserialize<float, 2>(storage.data(), storage.size() * sizeof(double));
+        REQUIRE(view[2][4] == 124.f);
+    }
+
+    SECTION("invalid blobs") {
+        const std::size_t size = Serialization::getSerializedSize(buffer);
+        std::vector<double> storage(size / sizeof(double) + 1);
+        REQUIRE_THROWS(Serialization::serialize(buffer, storage.data(), size - 1));
+        Serialization::serialize(buffer, storage.data(), size);
+
+        REQUIRE_THROWS(Serialization::deserialize<float, 3>(storage.data(), size - 1));
+        REQUIRE_THROWS(Serialization::deserialize<int, 3>(storage.data(), size));      // type mismatch
+        REQUIRE_THROWS(Serialization::deserialize<double, 3>(storage.data(), size));   // type mismatch
+        REQUIRE_THROWS(Serialization::deserialize<float, 2>(storage.data(), size));    // dimension mismatch
+        REQUIRE_THROWS(Serialization::deserialize<float, 3>(storage.data(), 20));
+
+        char* bytes = reinterpret_cast<char*>(storage.data());
+        Serialization::Header header;
+        std::memcpy(&header, bytes, sizeof(header));
+        for (std::uint64_t corruptOffset : { std::uint64_t{0}, std::uint64_t{48}, ~std::uint64_t{0} - 63 }) {
+            Serialization::Header corrupted = header;
+            corrupted.dataOffset = corruptOffset; // data overlapping the header, or out of bounds (overflow)
+            std::memcpy(bytes, &corrupted, sizeof(corrupted));
+            REQUIRE_THROWS(Serialization::deserialize<float, 3>(storage.data(), size, false));
+        }
+        std::memcpy(bytes, &header, sizeof(header));
+        REQUIRE_NOTHROW(Serialization::deserialize<float, 3>(storage.data(), size));
+
+        bytes[size - 1] ^= 0x01; // corrupt data
+        REQUIRE_THROWS(Serialization::deserialize<float, 3>(storage.data(), size));
+        REQUIRE_NOTHROW(Serialization::deserialize<float, 3>(storage.data(), size, false));
+        bytes[0] = 'X'; // corrupt magic
+        REQUIRE_THROWS(Serialization::deserialize<float, 3>(storage.data(), size, false));
+    }
+
+    SECTION("file: memory-mapped load") {
+        const std::string path = "SerializationTest.hyb";
+        Serialization::writeFile(buffer, path);
+        {
+            auto loaded = Serialization::readFile<const float, 3>(path, MappedFile::Mode::ReadOnly, true);
+            REQUIRE(haveEqualElements(loaded, buffer));
+
+            auto modified = Serialization::readFile<float, 3>(path); // copy-on-write
+            modified[1][2][4] = -1.f;
+            REQUIRE(loaded[1][2][4] == 124.f);
+            REQUIRE_THROWS(Serialization::readFile<float, 2>(path));
+        }
+        std::remove(path.c_str());
+        REQUIRE_THROWS(Serialization::readFile<float, 3>(path));
+    }
+}
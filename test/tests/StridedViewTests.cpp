@@ -0,0 +1,256 @@
+//
+//  ╦ ╦┬ ┬┌─┐┌─┐┬─┐  ╔╗ ┬ ┬┌─┐┌─┐┌─┐┬─┐
+//  ╠═╣└┬┘├─┘├┤ ├┬┘  ╠╩╗│ │├┤ ├┤ ├┤ ├┬┘
+//  ╩ ╩ ┴ ┴  └─┘┴└─  ╚═╝└─┘└  └  └─┘┴└─
+//
+//  © 2023 Lorenz Bucher - all rights reserved
+//  https://github.com/Sidelobe/HyperBuffer
+
+#include "TestCommon.hpp"
+
+#include <numeric>
+#include <vector>
+
+#include "HyperBuffer.hpp"
+#include "MemorySentinel.hpp"
+
+using namespace slb;
+
+static_assert(std::is_trivially_copyable<StridedView<float, 4>>::value, "should be trivially copyable");
+static_assert(std::is_convertible<StridedView<float, 2>, StridedView<const float, 2>>::value, "should convert to const");
+static_assert(!std::is_convertible<StridedView<const float, 2>, StridedView<float, 2>>::value, "must not drop const");
+
+namespace
+{
+/** @returns true if the view refers to exactly the same elements as the (N=3) buffer */
+template<typename V, typename B>
+bool refersToSameElements(const V& view, B& buffer)
+{
+    for (int i=0; i < buffer.size(0); ++i) {
+        for (int j=0; j < buffer.size(1); ++j) {
+            for (int k=0; k < buffer.size(2); ++k) {
+                if (&view[i][j][k] != &buffer[i][j][k] || &view.at(i, j, k) != &buffer[i][j][k]) {
+                    return false;
+                }
+            }
+        }
+    }
+    return true;
+}
+} // namespace
+
+TEST_CASE("StridedView Tests")
+{
+    std::vector<int> data(2*3*4);
+    std::iota(data.begin(), data.end(), 0);
+
+    SECTION("construction from geometry") {
+        StridedView<int, 3> view(data.data(), BufferGeometry<3>(2, 3, 4));
+        REQUIRE(view.sizes() == std::array<int, 3>{2, 3, 4});
+        REQUIRE(view.strides() == std::array<offset_type, 3>{12, 4, 1});
+        REQUIRE(view.size(1) == 3);
+        REQUIRE(view.stride(0) == 12);
+        REQUIRE(view.data() == data.data());
+        REQUIRE(view.isContiguous());
+
+        REQUIRE(view[1][2][3] == 23);
+        REQUIRE(view.at(1, 0, 2) == 14);
+        view.at(0, 1, 1) = -5;
+        REQUIRE(data[5] == -5);
+
+        StridedView<int, 2> row = view[1];
+        REQUIRE(row.sizes() == std::array<int, 2>{3, 4});
+        REQUIRE(row.data() == &data[12]);
+        REQUIRE(row[1][1] == 17);
+
+        StridedView<const int, 3> readOnly = view;
+        REQUIRE(readOnly[1][2][3] == 23);
+        REQUIRE_THROWS(view.at(2, 0, 0));
+        REQUIRE_THROWS(view.at(0, -1, 0));
+    }
+
+    SECTION("arbitrary strides") {
+        // column-major 3x4 matrix
+        StridedView<int, 2> transposed(data.data(), {3, 4}, {1, 3});
+        REQUIRE_FALSE(transposed.isContiguous());
+        REQUIRE(transposed[2][1] == 5);
+        REQUIRE(transposed.at(1, 3) == 10);
+
+        StridedView<int, 1> everyOther(data.data() + 1, {5}, {2});
+        REQUIRE(everyOther[4] == 9);
+        REQUIRE(everyOther.at(2) == 5);
+    }
+
+    SECTION("creating & copying never allocates") {
+        ScopedMemorySentinel sentinel;
+        StridedView<int, 3> view(data.data(), BufferGeometry<3>(2, 3, 4));
+        auto copy = view;
+        auto subView = copy[1][2];
+        REQUIRE(subView[3] == 23);
+    }
+}
+
+TEST_CASE("StridedView: slicing")
+{
+    // [channel][sample] = channel * 100 + sample
+    HyperBuffer<int, 2> buffer(3, 256);
+    for (int ch=0; ch < 3; ++ch) {
+        for (int i=0; i < 256; ++i) {
+            buffer[ch][i] = ch * 100 + i;
+        }
+    }
+
+    SECTION("range") {
+        ScopedMemorySentinel sentinel;
+        auto window = buffer.slice(1, 128, 128); // samples 128-255 of every channel
+        REQUIRE(window.sizes() == std::array<int, 2>{3, 128});
+        REQUIRE(window[0][0] == 128);
+        REQUIRE(window[2][127] == 455);
+        REQUIRE(&window.at(1, 5) == &buffer[1][133]);
+        REQUIRE_FALSE(window.isContiguous());
+        REQUIRE_THROWS(window.at(1, 128));
+
+        auto channels = buffer.slice(0, 1, 2); // channels 1 & 2, all samples
+        REQUIRE(channels.isContiguous());
+        REQUIRE(channels[0][3] == 103);
+        REQUIRE(buffer.slice(1, 0, 0).size(1) == 0); // empty slice
+        REQUIRE(buffer.slice(1, 256, 0).data() == buffer.stridedView().data());
+        REQUIRE_THROWS(buffer.slice(1, 257, 0));
+        REQUIRE_THROWS(buffer.slice(0, -1, 0));
+    }
+
+    SECTION("steps") {
+        auto everyOther = buffer.slice(1, 1, 128, 2); // odd samples
+        REQUIRE(everyOther.strides() == std::array<offset_type, 2>{256, 2});
+        REQUIRE(everyOther[1][0] == 101);
+        REQUIRE(everyOther[2][127] == 455);
+
+        auto reversed = buffer.slice(1, 255, 256, -1);
+        REQUIRE(reversed[0][0] == 255);
+        REQUIRE(reversed[0][255] == 0);
+
+        auto channelsReversed = buffer.slice(0, 2, 3, -1);
+        REQUIRE(channelsReversed[0][7] == 207);
+        REQUIRE(channelsReversed[2][7] == 7);
+
+        // chained slices: every 4th sample of samples 64-127 of channel 2 & 1
+        auto chained = buffer.slice(1, 64, 64).slice(1, 0, 16, 4).slice(0, 2, 2, -1);
+        REQUIRE(chained.sizes() == std::array<int, 2>{2, 16});
+        REQUIRE(chained[0][1] == 268);
+        REQUIRE(chained[1][15] == 224);
+
+        REQUIRE_THROWS(buffer.slice(1, 1, 129, 2));
+        REQUIRE_THROWS(buffer.slice(1, 0, 1, 0));
+        REQUIRE_THROWS(buffer.slice(2, 0, 1));
+    }
+
+    SECTION("select along a dimension") {
+        auto firstSamples = buffer.stridedView().select(1, 0);
+        REQUIRE(firstSamples.sizes() == std::array<int, 1>{3});
+        REQUIRE(firstSamples[2] == 200);
+
+        const auto& constBuffer = buffer;
+        StridedView<const int, 1> lastSampleOddChannels = constBuffer.slice(0, 1, 1).select(1, 255);
+        REQUIRE(lastSampleOddChannels[0] == 355);
+        REQUIRE(buffer.stridedView().select(0, 1)[4] == buffer[1][4]);
+        REQUIRE_THROWS(buffer.stridedView().select(1, 256));
+
+        HyperBuffer<int, 3> buffer3D(2, 3, 4);
+        buffer3D[1][2][3] = 42;
+        auto middle = buffer3D.stridedView().select(1, 2); // [2][4]
+        REQUIRE(middle.sizes() == std::array<int, 2>{2, 4});
+        REQUIRE(middle[1][3] == 42);
+    }
+
+    SECTION("writing through a slice") {
+        auto odd = buffer.slice(1, 1, 128, 2);
+        for (int ch=0; ch < odd.size(0); ++ch) {
+            for (int i=0; i < odd.size(1); ++i) {
+                odd[ch][i] = -1;
+            }
+        }
+        REQUIRE(buffer[0][0] == 0);
+        REQUIRE(buffer[0][1] == -1);
+        REQUIRE(buffer[2][254] == 454);
+        REQUIRE(buffer[2][255] == -1);
+    }
+}
+
+TEST_CASE("StridedView: broadcasting")
+{
+    HyperBuffer<float, 1> gains(3);
+    gains[0] = 0.5f; gains[1] = 1.f; gains[2] = 2.f;
+
+    SECTION("explicit mapping of dimensions") {
+        auto perChannel = gains.broadcast<2>({ 3, 512 }, { 0 }); // [channel] -> [channel][sample]
+        REQUIRE(perChannel.sizes() == std::array<int, 2>{3, 512});
+        REQUIRE(perChannel.strides() == std::array<offset_type, 2>{1, 0});
+        REQUIRE(perChannel[1][511] == 1.f);
+        REQUIRE(&perChannel[2][0] == &perChannel.at(2, 100));
+        REQUIRE_FALSE(perChannel.isContiguous());
+
+        auto middle = gains.broadcast<3>({ 4, 3, 5 }, { 1 });
+        REQUIRE(middle.at(3, 2, 4) == 2.f);
+        REQUIRE(middle.strides() == std::array<offset_type, 3>{0, 1, 0});
+    }
+
+    SECTION("NumPy rules: trailing dimensions & extents of 1") {
+        auto perBin = gains.broadcast<2>({ 100, 3 }); // [bin] -> [frame][bin]
+        REQUIRE(perBin[99][2] == 2.f);
+        REQUIRE(perBin.stride(0) == 0);
+
+        HyperBuffer<int, 2> column(4, 1);
+        column[3][0] = 7;
+        const auto expanded = column.broadcast<2>({ 4, 6 });
+        REQUIRE(expanded[3][5] == 7);
+        REQUIRE(expanded.strides() == std::array<offset_type, 2>{1, 0});
+
+        // slices & broadcasts compose, and never allocate
+        ScopedMemorySentinel sentinel;
+        auto lastTwo = gains.slice(0, 1, 2).broadcast<2>({ 2, 2 }, { 1 });
+        REQUIRE(lastTwo[1][0] == 1.f);
+        REQUIRE(lastTwo[0][1] == 2.f);
+    }
+
+    SECTION("incompatible extents") {
+        REQUIRE_THROWS(gains.broadcast<2>({ 4, 512 }, { 0 }));
+        REQUIRE_THROWS(gains.broadcast<2>({ 3, 512 }));
+        REQUIRE_THROWS(gains.broadcast<2>({ 3, 512 }, { 2 }));
+    }
+}
+
+TEST_CASE("HyperBuffer: strided views")
+{
+    SECTION("owning") {
+        HyperBuffer<int, 3> buffer(3, 3, 8);
+        const auto& constBuffer = buffer;
+        ScopedMemorySentinel sentinel;
+        REQUIRE(refersToSameElements(buffer.stridedView(), buffer));
+        StridedView<const int, 3> constView = constBuffer.stridedView();
+        REQUIRE(constView.data() == &buffer[0][0][0]);
+    }
+
+    SECTION("padded rows") {
+        HyperBufferAligned<float, 3, 64> buffer(2, 3, 5);
+        auto view = buffer.stridedView();
+        REQUIRE(view.strides() == std::array<offset_type, 3>{3*16, 16, 1});
+        REQUIRE_FALSE(view.isContiguous());
+        REQUIRE(refersToSameElements(view, buffer));
+    }
+
+    SECTION("view, sub-view, single-block & static") {
+        std::vector<int> data(4*3*8);
+        HyperBufferView<int, 4> view(data.data(), 4, 3, 3, 8);
+        auto subView = view.subView(2);
+        REQUIRE(refersToSameElements(subView.stridedView(), subView));
+        REQUIRE(view.stridedView()[2].data() == subView[0][0]);
+
+        HyperBufferSingleBlock<int, 3, 32> singleBlock(2, 2, 3);
+        REQUIRE(refersToSameElements(singleBlock.stridedView(), singleBlock));
+
+        StaticHyperBuffer<double, 2, 3, 4> staticBuffer;
+        auto staticView = staticBuffer.stridedView();
+        REQUIRE(staticView.strides() == std::array<offset_type, 3>{12, 4, 1});
+        REQUIRE(refersToSameElements(staticView, staticBuffer));
+    }
+}
@@ -0,0 +1,81 @@
+//
+//  ╦ ╦┬ ┬┌─┐┌─┐┬─┐  ╔╗ ┬ ┬┌─┐┌─┐┌─┐┬─┐
+//  ╠═╣└┬┘├─┘├┤ ├┬┘  ╠╩╗│ │├┤ ├┤ ├┤ ├┬┘
+//  ╩ ╩ ┴ ┴  └─┘┴└─  ╚═╝└─┘└  └  └─┘┴└─
+//
+//  © 2023 Lorenz Bucher - all rights reserved
+//  https://github.com/Sidelobe/HyperBuffer
+
+#include "TestCommon.hpp"
+#include "MemorySentinel.hpp"
+
+#include <atomic>
+#include <vector>
+
+#include "ThreadPool.hpp"
+
+using namespace slb;
+
+TEST_CASE("ThreadPool Tests")
+{
+    ThreadPool pool(4);
+    REQUIRE(pool.getNumThreads() == 4);
+
+    SECTION("parallelFor: every item exactly once") {
+        auto schedule = GENERATE(ThreadPool::Schedule::Static, ThreadPool::Schedule::WorkStealing);
+        auto numItems = GENERATE(0, 1, 3, 4, 1001);
+        std::vector<std::atomic<int>> counts(static_cast<std::size_t>(numItems));
+        {   // no dynamic memory allocation
+            ScopedMemorySentinel sentinel;
+            pool.parallelFor(numItems, [&counts](int i) { counts[static_cast<std::size_t>(i)]++; }, schedule, 3);
+            pool.parallelFor(numItems, [&counts](int i) { counts[static_cast<std::size_t>(i)]++; }, schedule);
+        }
+        for (auto& count : counts) {
+            REQUIRE(count == 2);
+        }
+    }
+
+    SECTION("parallelForEach: sub-views of the outermost dimension") {
+        HyperBuffer<float, 3> buffer(8, 3, 16);
+        {   // no dynamic memory allocation
+            ScopedMemorySentinel sentinel;
+            parallelForEach(pool, buffer, [](auto subView, int i) {
+                subView[2][15] = static_cast<float>(i);
+            });
+        }
+        for (int i=0; i < 8; ++i) {
+            REQUIRE(buffer[i][2][15] == static_cast<float>(i));
+        }
+
+        float* channels[] = { buffer[0][0], buffer[1][0], buffer[2][0] };
+        HyperBufferViewNC<float, 2> nonContiguous(channels, 3, 16);
+        parallelForEach(pool, nonContiguous, [](auto channel, int i) {
+            for (int k=0; k < channel.size(0); ++k) {
+                channel[k] = static_cast<float>(-i);
+            }
+        }, ThreadPool::Schedule::WorkStealing);
+        REQUIRE(buffer[2][0][15] == -2.f);
+    }
+
+    SECTION("parallelForEach: flattened leading dimensions") {
+        HyperBuffer<int, 3> buffer(3, 5, 7);
+        parallelForEach<2>(pool, buffer, [](auto row, int index) {
+            for (int k=0; k < row.size(0); ++k) {
+                row[k] = index;
+            }
+        }, ThreadPool::Schedule::WorkStealing);
+        for (int i=0; i < 3; ++i) {
+            for (int j=0; j < 5; ++j) {
+                REQUIRE(buffer[i][j][6] == i * 5 + j);
+            }
+        }
+    }
+
+    SECTION("single thread") {
+        ThreadPool serial(1);
+        int sum = 0;
+        serial.parallelFor(10, [&sum](int i) { sum += i; });
+        REQUIRE(sum == 45);
+        REQUIRE_THROWS(ThreadPool(0));
+    }
+}